@@ -1,34 +1,99 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
+from esphome import automation
 from esphome.const import CONF_ID, CONF_UART_ID
 from esphome.components import uart
 
-# Переконайтесь, що залежності правильно налаштовані
-DEPENDENCIES = ["uart"]
+# uart підвантажується сам: з emulator: (хост, стенд) блоку uart: у конфігурації може не бути
+AUTO_LOAD = ["uart"]
 CODEOWNERS = ["@10der"]
 
+CONF_POLL_INTERVAL = "poll_interval"
+CONF_QUEUE_CAPACITY = "queue_capacity"
+CONF_OVERFLOW_POLICY = "overflow_policy"
+CONF_ON_QUEUE_OVERFLOW = "on_queue_overflow"
+CONF_EMULATOR = "emulator"
+CONF_LATENCY = "latency"
+CONF_DROP_RATE = "drop_rate"
+CONF_GARBAGE_RATE = "garbage_rate"
+CONF_UNSOLICITED_INTERVAL = "unsolicited_interval"
+CONF_TRACK_LENGTH = "track_length"
+CONF_TOTAL_FILES = "total_files"
+CONF_SEED = "seed"
+
 # Створення простору імен і класу
 dfplayer_pro_ns = cg.esphome_ns.namespace("dfplayer_pro")
 DFPlayerPro = dfplayer_pro_ns.class_("DFPlayerPro", cg.Component, uart.UARTDevice)
+DFPlayerEmulator = dfplayer_pro_ns.class_("DFPlayerEmulator", uart.UARTComponent)
+OverflowPolicy = dfplayer_pro_ns.enum("OverflowPolicy", is_class=True)
 
-# Схема конфігурації. Вона тепер розширюється схемою UART-пристрою, яка додає CONF_UART_ID
-# Це дозволяє вам використовувати uart_id: в esphome.yaml
-CONFIG_SCHEMA = cv.Schema(
+OVERFLOW_POLICIES = {
+    "drop_newest": OverflowPolicy.DROP_NEWEST,
+    "drop_oldest": OverflowPolicy.DROP_OLDEST,
+    "replace_same_type": OverflowPolicy.REPLACE_SAME_TYPE,
+}
+
+# Емулятор модуля замість справжнього UART (хост, стенд без плеєра)
+EMULATOR_SCHEMA = cv.Schema(
     {
-        cv.GenerateID(): cv.declare_id(DFPlayerPro),
+        cv.GenerateID(): cv.declare_id(DFPlayerEmulator),
+        cv.Optional(CONF_LATENCY, default="20ms"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_DROP_RATE, default=0.0): cv.percentage,
+        cv.Optional(CONF_GARBAGE_RATE, default=0.0): cv.percentage,
+        cv.Optional(CONF_UNSOLICITED_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_TRACK_LENGTH, default="3s"): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_TOTAL_FILES, default=10): cv.int_range(min=1, max=9999),
+        cv.Optional(CONF_SEED, default=1): cv.uint32_t,
     }
-).extend(cv.COMPONENT_SCHEMA).extend(uart.UART_DEVICE_SCHEMA)
+)
+
+# Схема конфігурації: або uart_id (справжній модуль), або emulator
+# Це дозволяє вам використовувати uart_id: в esphome.yaml
+CONFIG_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.GenerateID(): cv.declare_id(DFPlayerPro),
+            cv.Optional(CONF_UART_ID): cv.use_id(uart.UARTComponent),
+            cv.Optional(CONF_EMULATOR): EMULATOR_SCHEMA,
+            # Опитування стану модуля (вимкнено за замовчуванням): один запит на інтервал
+            cv.Optional(CONF_POLL_INTERVAL, default="0s"): cv.positive_time_period_milliseconds,
+            # Розмір черги команд (статичний пул) і що робити, коли вона заповнена
+            cv.Optional(CONF_QUEUE_CAPACITY, default=16): cv.int_range(min=2, max=64),
+            cv.Optional(CONF_OVERFLOW_POLICY, default="drop_newest"): cv.enum(OVERFLOW_POLICIES, lower=True),
+            cv.Optional(CONF_ON_QUEUE_OVERFLOW): automation.validate_automation(single=True),
+        }
+    ).extend(cv.COMPONENT_SCHEMA),
+    cv.has_exactly_one_key(CONF_UART_ID, CONF_EMULATOR),
+)
 
 # Функція, яка генерує код C++
 async def to_code(config):
-    # Отримати змінну UART-компонента з конфігурації
-    # Це створює посилання на той UART-компонент, який ви визначили в YAML
-    uart_component = await cg.get_variable(config[CONF_UART_ID])
+    if CONF_EMULATOR in config:
+        emu_config = config[CONF_EMULATOR]
+        uart_component = cg.new_Pvariable(emu_config[CONF_ID])
+        cg.add(uart_component.set_latency(emu_config[CONF_LATENCY]))
+        cg.add(uart_component.set_drop_rate(emu_config[CONF_DROP_RATE]))
+        cg.add(uart_component.set_garbage_rate(emu_config[CONF_GARBAGE_RATE]))
+        cg.add(uart_component.set_unsolicited_interval(emu_config[CONF_UNSOLICITED_INTERVAL]))
+        cg.add(uart_component.set_track_length(emu_config[CONF_TRACK_LENGTH]))
+        cg.add(uart_component.set_total_files(emu_config[CONF_TOTAL_FILES]))
+        cg.add(uart_component.set_seed(emu_config[CONF_SEED]))
+    else:
+        # Отримати змінну UART-компонента з конфігурації
+        # Це створює посилання на той UART-компонент, який ви визначили в YAML
+        uart_component = await cg.get_variable(config[CONF_UART_ID])
 
     # Створити новий екземпляр класу DFPlayerPro, передаючи uart_component до конструктора.
     # Це відповідає конструктору DFPlayerPro(uart::UARTComponent *parent) з вашого .h-файлу.
     var = cg.new_Pvariable(config[CONF_ID], uart_component)
-    
+
     # Зареєструвати компонент.
     await cg.register_component(var, config)
+    cg.add(var.set_poll_interval(config[CONF_POLL_INTERVAL]))
+    cg.add_define("DFPLAYER_PRO_QUEUE_CAPACITY", config[CONF_QUEUE_CAPACITY])
+    cg.add(var.set_overflow_policy(config[CONF_OVERFLOW_POLICY]))
 
+    if CONF_ON_QUEUE_OVERFLOW in config:
+        await automation.build_automation(
+            var.get_queue_overflow_trigger(), [(cg.std_string, "x")], config[CONF_ON_QUEUE_OVERFLOW]
+        )
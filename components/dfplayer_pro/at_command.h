@@ -0,0 +1,161 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace dfplayer_pro {
+
+// Команди модуля. Текст AT-команди формується лише в момент відправки (format_command).
+enum class Opcode : uint8_t {
+  WAKE,      // AT
+  LED,       // AT+LED=ON/OFF
+  PLAYMODE,  // AT+PLAYMODE=<n>
+  VOL,       // AT+VOL=<n>
+  PROMPT,    // AT+PROMPT=ON/OFF
+  PLAYNUM,   // AT+PLAYNUM=<n>
+  PLAYFILE,  // AT+PLAYFILE=<arg>
+  RAW,       // AT<arg> (send_cmd: "+CMD=VALUE", "+CMD", "=VALUE" або "" уже в arg)
+  QUERY,     // запит стану; num = Query
+};
+static constexpr size_t OPCODE_COUNT = static_cast<size_t>(Opcode::QUERY) + 1;
+
+inline const char *opcode_name(Opcode op) {
+  static const char *const NAMES[OPCODE_COUNT] = {"WAKE",    "LED",      "PLAYMODE", "VOL",  "PROMPT",
+                                                  "PLAYNUM", "PLAYFILE", "RAW",      "QUERY"};
+  return NAMES[static_cast<size_t>(op)];
+}
+
+// Запити стану (синтаксис модуля: VOL=?, PLAYMODE=?, QUERY=1..5)
+enum class Query : uint8_t {
+  VOLUME,
+  PLAY_MODE,
+  CURRENT_FILE,
+  TOTAL_FILES,
+  CURRENT_TIME,  // секунди від початку треку
+  TOTAL_TIME,    // тривалість треку, с
+  FILE_NAME,
+  COUNT,
+};
+
+// Типізована відповідь: число для всіх запитів, крім FILE_NAME (text); text живе лише під час колбеку
+struct QueryResult {
+  Query query;
+  int32_t value;
+  const char *text;
+};
+
+// Посилання на функцію без алокацій: вільна функція/лямбда без захоплень + контекст
+struct CommandCallback {
+  void (*fn)(void *ctx, bool ok){nullptr};
+  void *ctx{nullptr};
+
+  explicit operator bool() const { return this->fn != nullptr; }
+  void operator()(bool ok) const {
+    if (this->fn != nullptr)
+      this->fn(this->ctx, ok);
+  }
+};
+
+struct ResultCallback {
+  void (*fn)(void *ctx, bool ok, const QueryResult &result){nullptr};
+  void *ctx{nullptr};
+
+  explicit operator bool() const { return this->fn != nullptr; }
+  void operator()(bool ok, const QueryResult &result) const {
+    if (this->fn != nullptr)
+      this->fn(this->ctx, ok, result);
+  }
+};
+
+// Слот пулу команд: опкод + число або рядковий аргумент у вбудованому буфері
+struct Command {
+  static constexpr size_t ARG_LENGTH = 64;
+
+  Opcode op{Opcode::WAKE};
+  int32_t num{0};
+  char arg[ARG_LENGTH]{};
+  CommandCallback callback;
+  ResultCallback result;  // лише для Opcode::QUERY
+  uint32_t seq{0};           // порядок постановки (FIFO в межах пріоритету)
+  uint32_t enqueue_time{0};  // для обліку часу очікування в черзі
+  uint32_t start_time{0};
+  uint32_t not_before{0};  // повтор після паузи: не відправляти раніше
+  uint8_t attempts{0};
+  bool used{false};
+  bool sent{false};
+};
+
+// Менше = раніше. Пробудження першим, далі відтворення, налаштування, запити стану — в останню чергу
+inline uint8_t command_priority(Opcode op) {
+  switch (op) {
+    case Opcode::WAKE:
+      return 0;
+    case Opcode::PLAYNUM:
+    case Opcode::PLAYFILE:
+      return 1;
+    case Opcode::QUERY:
+      return 3;
+    default:
+      return 2;
+  }
+}
+
+// Ідемпотентні налаштування: у черзі лишається тільки останнє значення
+inline bool command_coalesces(Opcode op) {
+  return op == Opcode::VOL || op == Opcode::PLAYMODE || op == Opcode::LED || op == Opcode::PROMPT;
+}
+
+// Повтор після таймауту безпечний: повторна відправка не змінює результату.
+// Відтворення не повторюємо — відповідь могла загубитись, а трек уже заграти.
+inline bool command_retryable(Opcode op) { return command_coalesces(op) || op == Opcode::WAKE || op == Opcode::QUERY; }
+
+// Формує "AT...\r\n" у буфер; повертає довжину або 0, якщо не влізло
+inline size_t format_command(const Command &c, char *out, size_t size) {
+  int n = 0;
+  switch (c.op) {
+    case Opcode::WAKE:
+      n = snprintf(out, size, "AT\r\n");
+      break;
+    case Opcode::LED:
+      n = snprintf(out, size, "AT+LED=%s\r\n", c.num ? "ON" : "OFF");
+      break;
+    case Opcode::PLAYMODE:
+      n = snprintf(out, size, "AT+PLAYMODE=%d\r\n", (int) c.num);
+      break;
+    case Opcode::VOL:
+      n = snprintf(out, size, "AT+VOL=%d\r\n", (int) c.num);
+      break;
+    case Opcode::PROMPT:
+      n = snprintf(out, size, "AT+PROMPT=%s\r\n", c.num ? "ON" : "OFF");
+      break;
+    case Opcode::PLAYNUM:
+      n = snprintf(out, size, "AT+PLAYNUM=%d\r\n", (int) c.num);
+      break;
+    case Opcode::PLAYFILE:
+      n = snprintf(out, size, "AT+PLAYFILE=%s\r\n", c.arg);
+      break;
+    case Opcode::RAW:
+      n = snprintf(out, size, "AT%s\r\n", c.arg);
+      break;
+    case Opcode::QUERY:
+      switch (static_cast<Query>(c.num)) {
+        case Query::VOLUME:
+          n = snprintf(out, size, "AT+VOL=?\r\n");
+          break;
+        case Query::PLAY_MODE:
+          n = snprintf(out, size, "AT+PLAYMODE=?\r\n");
+          break;
+        default:
+          // CURRENT_FILE..FILE_NAME -> QUERY=1..5
+          n = snprintf(out, size, "AT+QUERY=%d\r\n", (int) c.num - (int) Query::CURRENT_FILE + 1);
+          break;
+      }
+      break;
+  }
+  return (n > 0 && static_cast<size_t>(n) < size) ? static_cast<size_t>(n) : 0;
+}
+
+}  // namespace dfplayer_pro
+}  // namespace esphome
@@ -0,0 +1,92 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace esphome {
+namespace dfplayer_pro {
+
+#define BUFFER_LENGTH 255
+
+// Класифікація рядка відповіді. Чи є OTHER відповіддю-значенням, чи
+// непрошеним повідомленням модуля, вирішує диспетчер за активною командою.
+enum class AtLineKind : uint8_t { OK, ERROR, OTHER };
+
+// Інкрементальний токенізатор AT-відповідей: байт за байтом у фіксований буфер,
+// рядок закінчується на LF (CR відкидається). Без алокацій; задовгий рядок обрізається.
+class AtLineParser {
+ public:
+  // true, коли рядок завершено — тоді доступні line()/kind() до наступного feed()
+  bool feed(uint8_t c) {
+    if (this->complete_) {
+      this->len_ = 0;
+      this->truncated_ = false;
+      this->complete_ = false;
+    }
+    if (c == '\r')
+      return false;
+    if (c == '\n') {
+      // порожні рядки (зайвий CRLF) пропускаємо
+      if (this->len_ == 0)
+        return false;
+      this->buf_[this->len_] = '\0';
+      this->kind_ = classify_(this->buf_, this->len_);
+      this->complete_ = true;
+      return true;
+    }
+    if (this->len_ < BUFFER_LENGTH)
+      this->buf_[this->len_++] = static_cast<char>(c);
+    else
+      this->truncated_ = true;
+    return false;
+  }
+
+  const char *line() const { return this->buf_; }
+  size_t length() const { return this->len_; }
+  AtLineKind kind() const { return this->kind_; }
+  bool truncated() const { return this->truncated_; }
+
+  // Значення відповіді: вміст [..], інакше все після '=', інакше весь рядок; без пробілів по краях.
+  // Пише '\0' у буфер рядка, тож line() після цього — лише значення
+  const char *value() {
+    char *begin = this->buf_;
+    char *end = this->buf_ + this->len_;
+    char *bracket = static_cast<char *>(memchr(begin, '[', this->len_));
+    if (bracket != nullptr) {
+      begin = bracket + 1;
+      char *close = static_cast<char *>(memchr(begin, ']', end - begin));
+      if (close != nullptr)
+        end = close;
+    } else {
+      char *eq = static_cast<char *>(memchr(begin, '=', this->len_));
+      if (eq != nullptr)
+        begin = eq + 1;
+    }
+    while (begin < end && *begin == ' ')
+      begin++;
+    while (end > begin && end[-1] == ' ')
+      end--;
+    *end = '\0';
+    return begin;
+  }
+
+ protected:
+  static AtLineKind classify_(const char *s, size_t len) {
+    while (len > 0 && s[len - 1] == ' ')
+      len--;
+    if (len == 2 && s[0] == 'O' && s[1] == 'K')
+      return AtLineKind::OK;
+    if (len >= 3 && (strncmp(s, "ERR", 3) == 0 || strncmp(s, "err", 3) == 0))
+      return AtLineKind::ERROR;
+    return AtLineKind::OTHER;
+  }
+
+  char buf_[BUFFER_LENGTH + 1]{};
+  size_t len_{0};
+  AtLineKind kind_{AtLineKind::OTHER};
+  bool truncated_{false};
+  bool complete_{false};
+};
+
+}  // namespace dfplayer_pro
+}  // namespace esphome
@@ -0,0 +1,68 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+namespace esphome {
+namespace dfplayer_pro {
+
+// Гістограма затримок з фіксованими кошиками по степенях двійки (мс):
+// [0], [1], [2..3], [4..7], ... , [1024..2047], [2048..). Лічильники насичуються.
+struct LatencyHistogram {
+  static constexpr size_t BUCKETS = 13;
+
+  uint16_t counts[BUCKETS]{};
+  uint32_t max_ms{0};
+
+  static size_t bucket_of(uint32_t ms) {
+    size_t b = 0;
+    while (ms != 0 && b < BUCKETS - 1) {
+      ms >>= 1;
+      b++;
+    }
+    return b;
+  }
+
+  void add(uint32_t ms) {
+    uint16_t &c = this->counts[bucket_of(ms)];
+    if (c != UINT16_MAX)
+      c++;
+    if (ms > this->max_ms)
+      this->max_ms = ms;
+  }
+
+  uint32_t count() const {
+    uint32_t n = 0;
+    for (uint16_t c : this->counts)
+      n += c;
+    return n;
+  }
+
+  // Верхня межа кошика, в якому лежить pct% вибірок (не більше за реальний максимум)
+  uint32_t percentile(uint8_t pct) const {
+    const uint32_t total = this->count();
+    if (total == 0)
+      return 0;
+    const uint32_t target = (total * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (size_t b = 0; b < BUCKETS; b++) {
+      seen += this->counts[b];
+      if (seen >= target)
+        return b == BUCKETS - 1 ? this->max_ms : std::min<uint32_t>(this->max_ms, (1u << b) - 1);
+    }
+    return this->max_ms;
+  }
+};
+
+// Облік по одному типу команди
+struct OpcodeStats {
+  LatencyHistogram wait;  // від постановки в чергу до відправки
+  LatencyHistogram rtt;   // від відправки до OK/ERROR/значення
+  uint32_t sent{0};
+  uint32_t ok{0};
+  uint32_t failed{0};  // ERROR або нерозібрана відповідь
+  uint32_t timeouts{0};
+};
+
+}  // namespace dfplayer_pro
+}  // namespace esphome
@@ -0,0 +1,222 @@
+#include "dfplayer_emulator.h"
+
+namespace esphome {
+namespace dfplayer_pro {
+
+static const char *const TAG = "DFPlayerEmulator";
+// Ім'я файлу, доки нічого не відтворювалось: порожній рядок парсер пропустив би, і запит чекав би таймауту
+static const char *const NO_FILE_NAME = "NONE";
+
+void DFPlayerEmulator::write_array(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    const char c = static_cast<char>(data[i]);
+    if (c == '\r')
+      continue;
+    if (c == '\n') {
+      if (!this->tx_line_.empty())
+        this->handle_line_(this->tx_line_);
+      this->tx_line_.clear();
+      continue;
+    }
+    this->tx_line_ += c;
+  }
+}
+
+bool DFPlayerEmulator::peek_byte(uint8_t *data) {
+  this->pump_();
+  if (this->rx_.empty())
+    return false;
+  *data = this->rx_.front();
+  return true;
+}
+
+bool DFPlayerEmulator::read_array(uint8_t *data, size_t len) {
+  this->pump_();
+  if (this->rx_.size() < len)
+    return false;
+  for (size_t i = 0; i < len; i++) {
+    data[i] = this->rx_.front();
+    this->rx_.pop_front();
+  }
+  return true;
+}
+
+int DFPlayerEmulator::available() {
+  this->pump_();
+  return static_cast<int>(this->rx_.size());
+}
+
+bool DFPlayerEmulator::chance_(float rate) {
+  if (rate <= 0)
+    return false;
+  // xorshift32: детерміновано для заданого seed
+  this->rng_ ^= this->rng_ << 13;
+  this->rng_ ^= this->rng_ >> 17;
+  this->rng_ ^= this->rng_ << 5;
+  return (this->rng_ % 10000) < static_cast<uint32_t>(rate * 10000);
+}
+
+bool DFPlayerEmulator::playing_() {
+  if (this->play_active_ && this->track_length_ms_ > 0 && this->now_() - this->play_started_ >= this->track_length_ms_)
+    this->play_active_ = false;
+  return this->play_active_;
+}
+
+void DFPlayerEmulator::pump_() {
+  const uint32_t now = this->now_();
+
+  if (this->unsolicited_interval_ms_ > 0 && now - this->last_unsolicited_ >= this->unsolicited_interval_ms_) {
+    this->last_unsolicited_ = now;
+    this->pending_.push_back({now, "UNSOLICITED " + std::to_string(now)});
+  }
+
+  // Відповіді видаються в порядку постановки, коли настав їхній час
+  while (!this->pending_.empty() && static_cast<int32_t>(now - this->pending_.front().due) >= 0) {
+    const std::string line = this->pending_.front().text + "\r\n";
+    this->pending_.pop_front();
+    for (char c : line) {
+      if (this->chance_(this->drop_rate_))
+        continue;
+      this->rx_.push_back(static_cast<uint8_t>(c));
+    }
+  }
+}
+
+void DFPlayerEmulator::reply_(const std::string &text) {
+  const uint32_t due = this->now_() + this->latency_ms_;
+  if (this->chance_(this->garbage_rate_))
+    this->pending_.push_back({due, "#@!garbage"});
+  this->pending_.push_back({due, text});
+}
+
+void DFPlayerEmulator::handle_line_(const std::string &line) {
+  this->commands_received_++;
+  ESP_LOGV(TAG, "RX: %s", line.c_str());
+
+  if (line == "AT") {
+    this->reply_("OK");
+    return;
+  }
+  if (line.compare(0, 3, "AT+") != 0) {
+    this->reply_("error");
+    return;
+  }
+
+  const size_t eq = line.find('=');
+  const std::string name = line.substr(3, eq == std::string::npos ? std::string::npos : eq - 3);
+  const std::string value = eq == std::string::npos ? "" : line.substr(eq + 1);
+  const bool query = value == "?";
+  auto on_off = [&](bool &field) {
+    if (value == "ON" || value == "OFF") {
+      field = value == "ON";
+      this->reply_("OK");
+    } else {
+      this->reply_("error");
+    }
+  };
+
+  // Документований набір (GET*/SET*) плюс синтаксис бібліотеки DFRobot (VOL=?, PLAYMODE=?, QUERY=n)
+  if (name == "SETVOLUME") {
+    this->volume_ = std::max(0, std::min(30, atoi(value.c_str())));
+    this->reply_("OK");
+  } else if (name == "SETPLAYMODE") {
+    this->play_mode_ = atoi(value.c_str());
+    this->reply_("OK");
+  } else if (name == "GETVOLUME") {
+    this->reply_(std::to_string(this->volume_));
+  } else if (name == "GETPLAYMODE") {
+    this->reply_(std::to_string(this->play_mode_));
+  } else if (name == "GETCURFILENUMBER") {
+    this->reply_(std::to_string(this->current_file_));
+  } else if (name == "GETTOTALFILE") {
+    this->reply_(std::to_string(this->total_files_));
+  } else if (name == "GETCURTIME") {
+    this->reply_(std::to_string(this->playing_() ? (this->now_() - this->play_started_) / 1000 : 0));
+  } else if (name == "GETTOTALTIME") {
+    this->reply_(std::to_string(this->track_length_ms_ / 1000));
+  } else if (name == "GETFILENAME") {
+    this->reply_(this->current_name_.empty() ? NO_FILE_NAME : this->current_name_);
+  } else if (name == "AMP") {
+    on_off(this->amp_);
+  } else if (name == "START" || name == "PAUSE") {
+    if (name == "START" && !this->play_active_ && this->current_file_ > 0) {
+      this->play_active_ = true;
+      this->play_started_ = this->now_();
+    } else if (name == "PAUSE") {
+      this->play_active_ = false;
+    }
+    this->reply_("OK");
+  } else if (name == "NEXT" || name == "LAST") {
+    const int step = name == "NEXT" ? 1 : -1;
+    this->current_file_ = (this->current_file_ - 1 + step + this->total_files_) % this->total_files_ + 1;
+    this->current_name_ = "/" + std::to_string(this->current_file_) + ".mp3";
+    this->play_active_ = true;
+    this->play_started_ = this->now_();
+    this->reply_("OK");
+  } else if (name == "DEL" || name == "FASTFORWARD" || name == "FASTREVERSE" || name == "BAUDRATE") {
+    this->reply_("OK");
+  } else if (name == "VOL") {
+    if (query) {
+      this->reply_("VOL = [" + std::to_string(this->volume_) + "]");
+      return;
+    }
+    int v = atoi(value.c_str());
+    if (!value.empty() && (value[0] == '+' || value[0] == '-'))
+      v += this->volume_;
+    this->volume_ = std::max(0, std::min(30, v));
+    this->reply_("OK");
+  } else if (name == "PLAYMODE") {
+    if (query) {
+      this->reply_("PLAYMODE = " + std::to_string(this->play_mode_));
+      return;
+    }
+    this->play_mode_ = atoi(value.c_str());
+    this->reply_("OK");
+  } else if (name == "LED") {
+    on_off(this->led_);
+  } else if (name == "PROMPT") {
+    on_off(this->prompt_);
+  } else if (name == "PLAYNUM") {
+    const int no = atoi(value.c_str());
+    if (no < 1 || no > this->total_files_) {
+      this->reply_("error");
+      return;
+    }
+    this->current_file_ = no;
+    this->current_name_ = "/" + std::to_string(no) + ".mp3";
+    this->play_active_ = true;
+    this->play_started_ = this->now_();
+    this->reply_("OK");
+  } else if (name == "PLAYFILE") {
+    this->current_name_ = value;
+    this->play_active_ = true;
+    this->play_started_ = this->now_();
+    this->reply_("OK");
+  } else if (name == "QUERY") {
+    switch (atoi(value.c_str())) {
+      case 1:
+        this->reply_(std::to_string(this->current_file_));
+        break;
+      case 2:
+        this->reply_(std::to_string(this->total_files_));
+        break;
+      case 3:
+        this->reply_(std::to_string(this->playing_() ? (this->now_() - this->play_started_) / 1000 : 0));
+        break;
+      case 4:
+        this->reply_(std::to_string(this->track_length_ms_ / 1000));
+        break;
+      case 5:
+        this->reply_(this->current_name_.empty() ? NO_FILE_NAME : this->current_name_);
+        break;
+      default:
+        this->reply_("error");
+        break;
+    }
+  } else {
+    this->reply_("error");
+  }
+}
+
+}  // namespace dfplayer_pro
+}  // namespace esphome
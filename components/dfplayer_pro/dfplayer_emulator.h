@@ -0,0 +1,84 @@
+#pragma once
+#include "esphome.h"
+#include "esphome/components/uart/uart.h"
+
+#include <deque>
+#include <functional>
+#include <string>
+
+namespace esphome {
+namespace dfplayer_pro {
+
+// Емулятор DFPlayer Pro на рівні UART: підставляється замість справжнього UART-компонента
+// (dfplayer_pro: emulator: ...), щоб ганяти чергу команд без підключеного модуля.
+// Відповідає на AT-набір з dfplayer_pro.cpp; затримка, втрачені байти, сміття і непрошені рядки налаштовуються.
+class DFPlayerEmulator : public uart::UARTComponent {
+ public:
+  void set_latency(uint32_t ms) { this->latency_ms_ = ms; }
+  // Частки 0..1: ймовірність втратити байт відповіді / вставити сміттєвий рядок перед відповіддю
+  void set_drop_rate(float rate) { this->drop_rate_ = rate; }
+  void set_garbage_rate(float rate) { this->garbage_rate_ = rate; }
+  // 0 = вимкнено; інакше кожні N мс модуль сам шле рядок
+  void set_unsolicited_interval(uint32_t ms) { this->unsolicited_interval_ms_ = ms; }
+  // Тривалість треку: після неї відтворення зупиняється
+  void set_track_length(uint32_t ms) { this->track_length_ms_ = ms; }
+  void set_total_files(int n) { this->total_files_ = n; }
+  void set_seed(uint32_t seed) { this->rng_ = seed ? seed : 1; }
+  void set_time_source(std::function<uint32_t()> source) { this->source_ = std::move(source); }
+
+  // --- uart::UARTComponent ---
+  void write_array(const uint8_t *data, size_t len) override;
+  bool peek_byte(uint8_t *data) override;
+  bool read_array(uint8_t *data, size_t len) override;
+  int available() override;
+  void flush() override {}
+
+  // --- стан емульованого модуля ---
+  int get_volume() const { return this->volume_; }
+  int get_play_mode() const { return this->play_mode_; }
+  bool is_playing() { return this->playing_(); }
+  uint32_t get_commands_received() const { return this->commands_received_; }
+
+ protected:
+  void check_logger_conflict() override {}
+
+  uint32_t now_() const { return this->source_ ? this->source_() : millis(); }
+  bool chance_(float rate);
+  bool playing_();
+  void pump_();
+  void handle_line_(const std::string &line);
+  void reply_(const std::string &text);
+
+  struct Pending {
+    uint32_t due;
+    std::string text;
+  };
+
+  std::function<uint32_t()> source_;
+  std::string tx_line_;
+  std::deque<Pending> pending_;
+  std::deque<uint8_t> rx_;
+
+  uint32_t latency_ms_{20};
+  float drop_rate_{0};
+  float garbage_rate_{0};
+  uint32_t unsolicited_interval_ms_{0};
+  uint32_t last_unsolicited_{0};
+  uint32_t rng_{1};
+  uint32_t commands_received_{0};
+
+  int volume_{15};
+  int play_mode_{1};
+  bool led_{true};
+  bool amp_{true};
+  bool prompt_{true};
+  int total_files_{10};
+  int current_file_{0};
+  std::string current_name_;
+  uint32_t track_length_ms_{3000};
+  uint32_t play_started_{0};
+  bool play_active_{false};
+};
+
+}  // namespace dfplayer_pro
+}  // namespace esphome
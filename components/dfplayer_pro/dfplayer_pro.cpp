@@ -14,19 +14,138 @@ void DFPlayerPro::init() {
   // Ініціалізація UART для DFPlayer Pro без затримки
   this->initialized_ = false;
 
-  send_command("AT\r\n", [](bool ok) { ESP_LOGI("DFPlayer", "Wakeup: %s", ok ? "OK" : "ERR"); });
+  send_command(Opcode::WAKE, 0, nullptr,
+               {[](void *, bool ok) { ESP_LOGI("DFPlayer", "Wakeup: %s", ok ? "OK" : "ERR"); }});
 
-  send_command("AT+LED=OFF\r\n", [](bool ok) { ESP_LOGI("DFPlayer", "LED: %s", ok ? "OK" : "ERR"); });
+  send_command(Opcode::LED, 0, nullptr, {[](void *, bool ok) { ESP_LOGI("DFPlayer", "LED: %s", ok ? "OK" : "ERR"); }});
 
-  send_command("AT+PLAYMODE=3\r\n", [](bool ok) { ESP_LOGI("DFPlayer", "PlayMode: %s", ok ? "OK" : "ERR"); });
+  send_command(Opcode::PLAYMODE, 3, nullptr,
+               {[](void *, bool ok) { ESP_LOGI("DFPlayer", "PlayMode: %s", ok ? "OK" : "ERR"); }});
 
-  send_command("AT+VOL=30\r\n", [](bool ok) { ESP_LOGI("DFPlayer", "Volume: %s", ok ? "OK" : "ERR"); });
+  send_command(Opcode::VOL, 30, nullptr,
+               {[](void *, bool ok) { ESP_LOGI("DFPlayer", "Volume: %s", ok ? "OK" : "ERR"); }});
 
   this->initialized_ = true;
 }
 
-void DFPlayerPro::send_command(const std::string &cmd, std::function<void(bool)> cb) {
-  queue_.push_back({cmd, cb, 0, false});
+bool DFPlayerPro::send_command(Opcode op, int32_t num, const char *arg, CommandCallback cb) {
+  return this->enqueue_(op, num, arg, cb) != nullptr;
+}
+
+Command *DFPlayerPro::enqueue_(Opcode op, int32_t num, const char *arg, CommandCallback cb) {
+  const size_t arg_len = arg != nullptr ? strlen(arg) : 0;
+  if (arg_len >= Command::ARG_LENGTH) {
+    ESP_LOGW(TAG, "Command argument too long (%u bytes): %s", (unsigned) arg_len, arg);
+    return nullptr;
+  }
+
+  // Злиття: ще не відправлене таке саме налаштування просто отримує нове значення і місце в черзі не змінює
+  if (command_coalesces(op)) {
+    for (auto &c : this->pool_) {
+      if (!c.used || c.sent || c.op != op)
+        continue;
+      c.num = num;
+      if (cb) {
+        // попередній колбек уже не дочекається своєї команди
+        const CommandCallback superseded = c.callback;
+        c.callback = cb;
+        superseded(false);
+      }
+      this->coalesced_count_++;
+      return &c;
+    }
+  }
+
+  if (this->count_ >= QUEUE_CAPACITY && !this->make_room_(op)) {
+    this->overflows_++;
+    ESP_LOGW(TAG, "Command queue full (%u), dropping new %s", (unsigned) QUEUE_CAPACITY, opcode_name(op));
+    this->queue_overflow_trigger_->trigger(opcode_name(op));
+    return nullptr;
+  }
+  Command *slot = nullptr;
+  for (auto &c : this->pool_) {
+    if (!c.used) {
+      slot = &c;
+      break;
+    }
+  }
+  // колбек витісненої команди міг сам зайняти звільнений слот
+  if (slot == nullptr) {
+    ESP_LOGW(TAG, "Command queue full, dropping new %s", opcode_name(op));
+    return nullptr;
+  }
+  Command &c = *slot;
+  c.op = op;
+  c.num = num;
+  c.arg[0] = '\0';
+  if (arg != nullptr)
+    memcpy(c.arg, arg, arg_len + 1);
+  c.callback = cb;
+  c.result = {};
+  c.not_before = 0;
+  c.attempts = 0;
+  c.seq = this->next_seq_++;
+  c.enqueue_time = this->now_();
+  c.start_time = 0;
+  c.used = true;
+  c.sent = false;
+  this->count_++;
+  this->max_depth_ = std::max(this->max_depth_, this->count_);
+  this->high_water_ = std::max(this->high_water_, this->count_);
+  return &c;
+}
+
+bool DFPlayerPro::make_room_(Opcode op) {
+  if (this->overflow_policy_ == OverflowPolicy::DROP_NEWEST)
+    return false;
+  // Активна (вже відправлена) команда не витісняється — на неї ще чекаємо відповідь
+  Command *victim = nullptr;
+  for (auto &c : this->pool_) {
+    if (!c.used || c.sent)
+      continue;
+    if (this->overflow_policy_ == OverflowPolicy::REPLACE_SAME_TYPE && c.op != op)
+      continue;
+    if (victim == nullptr || static_cast<int32_t>(c.seq - victim->seq) < 0)
+      victim = &c;
+  }
+  if (victim == nullptr)
+    return false;
+  this->overflows_++;
+  ESP_LOGW(TAG, "Command queue full (%u), evicting %s", (unsigned) QUEUE_CAPACITY, opcode_name(victim->op));
+  this->queue_overflow_trigger_->trigger(opcode_name(victim->op));
+  this->evict_(*victim);
+  return true;
+}
+
+void DFPlayerPro::evict_(Command &c) {
+  // Спершу звільняємо слот, потім колбек — як і при завершенні команди
+  const Command done = c;
+  c.used = false;
+  this->count_--;
+  if (done.op == Opcode::QUERY)
+    done.result(false, QueryResult{static_cast<Query>(done.num), -1, nullptr});
+  else
+    done.callback(false);
+}
+
+Command *DFPlayerPro::next_command_() {
+  Command *best = nullptr;
+  for (auto &c : this->pool_) {
+    if (!c.used || c.sent)
+      continue;
+    // повтор ще чекає своєї паузи
+    if (c.attempts > 0 && static_cast<int32_t>(this->now_() - c.not_before) < 0)
+      continue;
+    if (best == nullptr) {
+      best = &c;
+      continue;
+    }
+    const uint8_t pc = command_priority(c.op), pb = command_priority(best->op);
+    // seq порівнюємо через різницю — переживає переповнення лічильника
+    if (pc < pb || (pc == pb && static_cast<int32_t>(c.seq - best->seq) < 0))
+      best = &c;
+  }
+  return best;
 }
 
 /*
@@ -54,108 +173,394 @@ AT+SETVOLUME=<volume_level>: Sets the volume level (0-30).
 AT+SETPLAYMODE=<mode>: Sets the playback mode (e.g., single play, loop).
 */
 
-void DFPlayerPro::send_cmd(const std::string cmd, const std::string value) {
+bool DFPlayerPro::send_cmd(const std::string &cmd, const std::string &value) {
   if (!this->initialized_) {
     ESP_LOGW(TAG, "Компонент ще не ініціалізовано. Команда ігнорується.");
-    return;
+    return false;
   }
 
-   std::string atCmd = "";
-   atCmd += "AT";
-   if (!cmd.empty()) {
-      atCmd += "+";
-      atCmd += cmd;
-   }
-
-   if (!value.empty()) {
-      atCmd += "=";
-      atCmd += value;
-   }
-   atCmd += "\r\n";
-
-  this->send_command(atCmd);
+  // Хвіст після "AT" як в оригіналі: "+CMD", "=VALUE" лише за наявності
+  char arg[Command::ARG_LENGTH];
+  const int n = snprintf(arg, sizeof(arg), "%s%s%s%s", cmd.empty() ? "" : "+", cmd.c_str(), value.empty() ? "" : "=",
+                         value.c_str());
+  if (n < 0 || static_cast<size_t>(n) >= sizeof(arg)) {
+    ESP_LOGW(TAG, "Command too long (%d bytes), ignored: AT+%s=%s", n, cmd.c_str(), value.c_str());
+    return false;
+  }
+  return this->send_command(Opcode::RAW, 0, arg);
 }
 
-void DFPlayerPro::set_prompt(bool on_off) {
+bool DFPlayerPro::set_prompt(bool on_off) {
   if (!this->initialized_) {
     ESP_LOGW(TAG, "Компонент ще не ініціалізовано. Команда ігнорується.");
-    return;
+    return false;
   }
-  if (on_off) {
-    this->send_command("AT+PROMPT=ON\r\n");
-  } else {
-    this->send_command("AT+PROMPT=OFF\r\n");
+  return this->send_command(Opcode::PROMPT, on_off ? 1 : 0);
+}
+
+bool DFPlayerPro::play_file(const std::string &file_name) {
+  if (!this->initialized_) {
+    ESP_LOGW(TAG, "Компонент ще не ініціалізовано. Команда ігнорується.");
+    return false;
   }
+  return this->send_command(Opcode::PLAYFILE, 0, file_name.c_str());
 }
 
-void DFPlayerPro::play_file(const std::string file_name) {
+bool DFPlayerPro::play_file_no(int no, CommandCallback cb) {
   if (!this->initialized_) {
     ESP_LOGW(TAG, "Компонент ще не ініціалізовано. Команда ігнорується.");
-    return;
+    return false;
   }
-  this->send_command("AT+PLAYFILE=" + file_name + "\r\n");
+  return this->send_command(Opcode::PLAYNUM, no, nullptr, cb);
 }
 
-void DFPlayerPro::play_file_no(int no) {
+bool DFPlayerPro::set_volume(int value) {
   if (!this->initialized_) {
     ESP_LOGW(TAG, "Компонент ще не ініціалізовано. Команда ігнорується.");
-    return;
+    return false;
   }
-  this->send_command("AT+PLAYNUM=" + std::to_string(no) + "\r\n");
+  return this->send_command(Opcode::VOL, value);
 }
 
-void DFPlayerPro::set_volume(int value) {
+bool DFPlayerPro::set_play_mode(int mode) {
   if (!this->initialized_) {
     ESP_LOGW(TAG, "Компонент ще не ініціалізовано. Команда ігнорується.");
+    return false;
+  }
+  return this->send_command(Opcode::PLAYMODE, mode);
+}
+
+uint32_t DFPlayerPro::timeout_for_(Opcode op) const {
+  // Модуль не відповідає — не тримаємо чергу секундами на кожну команду
+  if (this->degraded_)
+    return MIN_TIMEOUT_MS;
+  const LatencyHistogram &rtt = this->stats_[static_cast<size_t>(op)].rtt;
+  if (rtt.count() < TIMEOUT_MIN_SAMPLES)
+    return this->timeout_ms_;
+  return std::max(MIN_TIMEOUT_MS, std::min(this->timeout_ms_, rtt.percentile(99) * TIMEOUT_P99_FACTOR));
+}
+
+void DFPlayerPro::check_recovery_() {
+  const uint32_t now = this->now_();
+  if (this->reinits_ > 0 && now - this->last_reinit_ < REINIT_MIN_INTERVAL_MS)
     return;
+  // N таймаутів поспіль, або модуль досі мовчить, а черга вже порожня — пробуємо знову
+  if (this->consecutive_timeouts_ < REINIT_AFTER_TIMEOUTS && !(this->degraded_ && this->count_ == 0))
+    return;
+  this->consecutive_timeouts_ = 0;
+  this->last_reinit_ = now;
+  this->reinits_++;
+  if (!this->degraded_)
+    ESP_LOGW(TAG, "DFPlayer not responding, re-running init");
+  this->degraded_ = true;
+
+  // Запити стану в черзі вже неактуальні — закриваємо одразу
+  for (auto &c : this->pool_) {
+    if (c.used && !c.sent && c.op == Opcode::QUERY)
+      this->evict_(c);
   }
-  this->send_command("AT+VOL=" + std::to_string(value) + "\r\n");
+
+  // Ініціалізація заново (WAKE піде першим), далі — останні відомі налаштування поверх значень init()
+  const int volume = this->get_volume();
+  const int play_mode = this->get_play_mode();
+  this->init();
+  if (volume >= 0)
+    this->send_command(Opcode::VOL, volume);
+  if (play_mode >= 0)
+    this->send_command(Opcode::PLAYMODE, play_mode);
 }
 
 void DFPlayerPro::process_active() {
-  // Читаємо все, що є в UART
-  while (this->available()) {
-    uint8_t c;
-    this->read_byte(&c);
-    response_buffer_ += (char) c;
-    // Кінець відповіді?
-    if (response_buffer_.size() >= 2 && response_buffer_[response_buffer_.size() - 2] == '\r' &&
-        response_buffer_[response_buffer_.size() - 1] == '\n') {
-      bool ok = response_buffer_.find("OK") != std::string::npos;
-      ESP_LOGI(TAG, "DFPlayer response: %s", response_buffer_.c_str());
-
-      if (active_->callback)
-        active_->callback(ok);
-
-      queue_.pop_front();  // видаляємо з черги
-      active_ = nullptr;   // звільняємо слот
+  // Таймаут
+  if (this->now_() - active_->start_time > this->timeout_for_(active_->op)) {
+    ESP_LOGE(TAG, "Timeout for command: %s", this->tx_buffer_);
+    this->complete_active_(Outcome::TIMEOUT);
+  }
+}
+
+void DFPlayerPro::complete_active_(Outcome outcome, const char *reply) {
+  if (outcome == Outcome::TIMEOUT) {
+    this->consecutive_timeouts_++;
+    // Ідемпотентну команду повторюємо з паузою, що подвоюється; поки модуль недоступний — без повторів
+    if (!this->degraded_ && command_retryable(active_->op) && active_->attempts < MAX_RETRIES) {
+      this->record_outcome_(*active_, outcome);
+      active_->not_before = this->now_() + (RETRY_BACKOFF_MS << active_->attempts);
+      active_->enqueue_time = active_->not_before;
+      active_->attempts++;
+      active_->sent = false;
+      active_ = nullptr;
+      this->retries_++;
+      this->check_recovery_();
       return;
     }
+  } else {
+    // будь-яка відповідь модуля (навіть ERROR) означає, що він живий
+    this->consecutive_timeouts_ = 0;
+    if (this->degraded_) {
+      this->degraded_ = false;
+      ESP_LOGI(TAG, "DFPlayer responding again");
+    }
   }
 
-  // Таймаут
-  if (millis() - active_->start_time > timeout_ms_) {
-    ESP_LOGE(TAG, "Timeout for command: %s", active_->cmd.c_str());
-    if (active_->callback)
-      active_->callback(false);
-    queue_.pop_front();
-    active_ = nullptr;
+  // Спершу звільняємо слот: колбек може поставити нову команду
+  const Command done = *active_;
+  active_->used = false;
+  this->count_--;
+  active_ = nullptr;
+  bool ok = outcome == Outcome::OK;
+
+  if (done.op == Opcode::QUERY) {
+    const Query q = static_cast<Query>(done.num);
+    QueryResult result{q, -1, nullptr};
+    if (ok && reply != nullptr) {
+      if (q == Query::FILE_NAME) {
+        result.text = reply;
+      } else {
+        char *end = nullptr;
+        result.value = strtol(reply, &end, 10);
+        ok = end != reply;
+      }
+    } else {
+      ok = false;
+    }
+    // відповідь прийшла, але не розібралась — це збій, не успіх
+    this->record_outcome_(done, (outcome == Outcome::OK && !ok) ? Outcome::FAILED : outcome);
+    if (ok)
+      this->update_state_(q, result.value, result.text);
+    done.result(ok, result);
+    this->check_recovery_();
+    return;
+  }
+
+  this->record_outcome_(done, outcome);
+
+  // Підтверджені налаштування і відтворення теж оновлюють кеш — без окремого запиту
+  if (ok) {
+    switch (done.op) {
+      case Opcode::VOL:
+        this->update_state_(Query::VOLUME, done.num, nullptr);
+        break;
+      case Opcode::PLAYMODE:
+        this->update_state_(Query::PLAY_MODE, done.num, nullptr);
+        break;
+      case Opcode::PLAYNUM:
+        this->update_state_(Query::CURRENT_FILE, done.num, nullptr);
+        this->track_started_();
+        break;
+      case Opcode::PLAYFILE:
+        this->update_state_(Query::FILE_NAME, 0, done.arg);
+        this->track_started_();
+        break;
+      default:
+        break;
+    }
+  }
+  done.callback(ok);
+  this->check_recovery_();
+}
+
+void DFPlayerPro::record_outcome_(const Command &done, Outcome outcome) {
+  OpcodeStats &st = this->stats_[static_cast<size_t>(done.op)];
+  // RTT — лише для відповідей: таймаути інакше роздували б вивчений таймаут
+  if (done.sent && outcome != Outcome::TIMEOUT)
+    st.rtt.add(this->now_() - done.start_time);
+  switch (outcome) {
+    case Outcome::OK:
+      st.ok++;
+      break;
+    case Outcome::FAILED:
+      st.failed++;
+      this->failed_++;
+      break;
+    case Outcome::TIMEOUT:
+      st.timeouts++;
+      this->timeouts_++;
+      break;
   }
 }
 
+void DFPlayerPro::reset_stats() {
+  for (auto &st : this->stats_)
+    st = OpcodeStats{};
+  this->timeouts_ = 0;
+  this->failed_ = 0;
+  this->retries_ = 0;
+  this->reinits_ = 0;
+  this->max_depth_ = this->count_;
+  this->queue_wait_last_ms_ = 0;
+  this->queue_wait_max_ms_ = 0;
+  this->queue_wait_total_ms_ = 0;
+  this->sent_count_ = 0;
+  this->coalesced_count_ = 0;
+  this->overflows_ = 0;
+  this->unsolicited_count_ = 0;
+}
+
+void DFPlayerPro::get_stats_json(std::string &out) const {
+  char buf[320];
+  snprintf(buf, sizeof(buf),
+           "{\"sent\":%u,\"timeouts\":%u,\"failed\":%u,\"retries\":%u,\"reinits\":%u,\"unsolicited\":%u,"
+           "\"coalesced\":%u,\"overflows\":%u,\"depth\":%u,\"max_depth\":%u,\"high_water\":%u,\"capacity\":%u,"
+           "\"degraded\":%s,\"ops\":{",
+           (unsigned) this->sent_count_, (unsigned) this->timeouts_, (unsigned) this->failed_, (unsigned) this->retries_,
+           (unsigned) this->reinits_, (unsigned) this->unsolicited_count_, (unsigned) this->coalesced_count_,
+           (unsigned) this->overflows_, (unsigned) this->count_, (unsigned) this->max_depth_, (unsigned) this->high_water_,
+           (unsigned) QUEUE_CAPACITY, this->degraded_ ? "true" : "false");
+  out = buf;
+  bool first = true;
+  for (size_t i = 0; i < OPCODE_COUNT; i++) {
+    const OpcodeStats &st = this->stats_[i];
+    if (st.sent == 0)
+      continue;
+    snprintf(buf, sizeof(buf),
+             "%s\"%s\":{\"n\":%u,\"ok\":%u,\"fail\":%u,\"to\":%u,\"wait_p50\":%u,\"wait_p99\":%u,"
+             "\"rtt_p50\":%u,\"rtt_p99\":%u,\"rtt_max\":%u}",
+             first ? "" : ",", opcode_name(static_cast<Opcode>(i)), (unsigned) st.sent, (unsigned) st.ok,
+             (unsigned) st.failed, (unsigned) st.timeouts, (unsigned) st.wait.percentile(50),
+             (unsigned) st.wait.percentile(99), (unsigned) st.rtt.percentile(50), (unsigned) st.rtt.percentile(99),
+             (unsigned) st.rtt.max_ms);
+    out += buf;
+    first = false;
+  }
+  out += "}}";
+}
+
+void DFPlayerPro::update_state_(Query q, int32_t value, const char *text) {
+  const size_t i = static_cast<size_t>(q);
+  const uint32_t now = this->now_();
+  if (q == Query::CURRENT_TIME) {
+    // Ненульовий час — трек грає, і з нього видно, коли він почався; 0 після старту — зупинка
+    if (value > 0) {
+      this->state_.playing = true;
+      this->state_.play_started = now - static_cast<uint32_t>(value) * 1000;
+    } else if (now - this->state_.play_started >= PLAY_START_GRACE_MS) {
+      this->state_.playing = false;
+    }
+  }
+  if (q == Query::FILE_NAME && text != nullptr)
+    snprintf(this->state_.file_name, sizeof(this->state_.file_name), "%s", text);
+  this->state_.values[i] = value;
+  this->state_.updated[i] = now;
+}
+
+void DFPlayerPro::track_started_() {
+  this->state_.playing = true;
+  this->state_.play_started = this->now_();
+  for (Query q : {Query::CURRENT_TIME, Query::TOTAL_TIME}) {
+    this->state_.values[static_cast<size_t>(q)] = -1;
+    this->state_.updated[static_cast<size_t>(q)] = 0;
+  }
+  this->query(Query::TOTAL_TIME);
+}
+
+bool DFPlayerPro::is_playing() const {
+  if (!this->state_.playing)
+    return false;
+  // Тривалість ще не відома (запит у черзі або не вдався) — покладаємося на підтвердження старту
+  const int32_t total_s = this->state_.values[static_cast<size_t>(Query::TOTAL_TIME)];
+  if (total_s <= 0)
+    return true;
+  return this->now_() - this->state_.play_started < static_cast<uint32_t>(total_s) * 1000 + PLAY_END_SLACK_MS;
+}
+
+bool DFPlayerPro::query(Query q, ResultCallback cb, uint32_t max_age_ms) {
+  const size_t i = static_cast<size_t>(q);
+  if (i >= static_cast<size_t>(Query::COUNT))
+    return false;
+  if (max_age_ms > 0 && this->state_.updated[i] != 0 && this->now_() - this->state_.updated[i] <= max_age_ms) {
+    cb(true, QueryResult{q, this->state_.values[i], q == Query::FILE_NAME ? this->state_.file_name : nullptr});
+    return true;
+  }
+  // Однаковий запит без колбеку, що ще чекає в черзі, не дублюємо
+  if (!cb) {
+    for (auto &c : this->pool_) {
+      if (c.used && !c.sent && c.op == Opcode::QUERY && c.num == static_cast<int32_t>(q))
+        return true;
+    }
+  }
+  Command *c = this->enqueue_(Opcode::QUERY, static_cast<int32_t>(q));
+  if (c == nullptr)
+    return false;
+  c->result = cb;
+  return true;
+}
+
+void DFPlayerPro::poll_() {
+  if (this->poll_interval_ms_ == 0 || !this->initialized_ || this->count_ > 0)
+    return;
+  const uint32_t now = this->now_();
+  if (now - this->last_poll_ < this->poll_interval_ms_)
+    return;
+  this->last_poll_ = now;
+  // Поточний час треку опитуємо через раз (з нього видно, чи грає), решту — по колу
+  static const Query ROTATION[] = {Query::CURRENT_TIME, Query::VOLUME,       Query::CURRENT_TIME,
+                                   Query::PLAY_MODE,    Query::CURRENT_TIME, Query::CURRENT_FILE,
+                                   Query::CURRENT_TIME, Query::TOTAL_FILES};
+  this->query(ROTATION[this->poll_index_]);
+  this->poll_index_ = (this->poll_index_ + 1) % (sizeof(ROTATION) / sizeof(ROTATION[0]));
+}
+
+void DFPlayerPro::handle_line_() {
+  const AtLineKind kind = this->parser_.kind();
+  ESP_LOGD(TAG, "DFPlayer response: %s%s", this->parser_.line(), this->parser_.truncated() ? " (truncated)" : "");
+
+  // Запит закривається рядком-значенням (або ERROR)
+  if (active_ != nullptr && active_->op == Opcode::QUERY) {
+    if (kind == AtLineKind::OTHER) {
+      const bool whole_line = static_cast<Query>(active_->num) == Query::FILE_NAME;
+      this->complete_active_(Outcome::OK, whole_line ? this->parser_.line() : this->parser_.value());
+    } else {
+      this->complete_active_(Outcome::FAILED);
+    }
+    return;
+  }
+  // OK/ERROR закривають активну команду; решта — повідомлення модуля, а не відповідь на неї
+  if (active_ != nullptr && kind != AtLineKind::OTHER) {
+    this->complete_active_(kind == AtLineKind::OK ? Outcome::OK : Outcome::FAILED);
+    return;
+  }
+  this->unsolicited_count_++;
+  ESP_LOGD(TAG, "Unsolicited: %s", this->parser_.line());
+}
+
 void DFPlayerPro::loop() {
+  // Читаємо все, що є в UART, навіть без активної команди — щоб непрошені рядки не склеювались з відповіддю
+  uint8_t c;
+  while (this->available() && this->read_byte(&c)) {
+    if (this->parser_.feed(c))
+      this->handle_line_();
+  }
+
   // Якщо немає активної команди і є в черзі — беремо її
-  if (active_ == nullptr && !queue_.empty()) {
-    active_ = &queue_.front();
-    active_->start_time = millis();
-    this->write_str(active_->cmd.c_str());
-    ESP_LOGD(TAG, "Sent command: %s", active_->cmd.c_str());
+  if (active_ == nullptr && this->count_ > 0)
+    active_ = this->next_command_();
+  if (active_ != nullptr && !active_->sent) {
+    // Текст команди формуємо лише тут, прямо в TX-буфер
+    const size_t len = format_command(*active_, this->tx_buffer_, sizeof(this->tx_buffer_));
+    if (len == 0) {
+      ESP_LOGE(TAG, "Cannot format opcode %d", (int) active_->op);
+      this->complete_active_(Outcome::FAILED);
+      return;
+    }
+    active_->start_time = this->now_();
+    this->queue_wait_last_ms_ = active_->start_time - active_->enqueue_time;
+    this->queue_wait_max_ms_ = std::max(this->queue_wait_max_ms_, this->queue_wait_last_ms_);
+    this->queue_wait_total_ms_ += this->queue_wait_last_ms_;
+    this->sent_count_++;
+    OpcodeStats &st = this->stats_[static_cast<size_t>(active_->op)];
+    st.sent++;
+    st.wait.add(this->queue_wait_last_ms_);
+    this->write_array(reinterpret_cast<const uint8_t *>(this->tx_buffer_), len);
+    ESP_LOGD(TAG, "Sent command: %s", this->tx_buffer_);
     active_->sent = true;
-    response_buffer_.clear();
   }
 
   if (active_ != nullptr) {
     process_active();
+  } else if (this->degraded_) {
+    this->check_recovery_();
+  } else {
+    this->poll_();
   }
 }
 
@@ -1,11 +1,25 @@
 #pragma once
 #include "esphome.h"
 #include "esphome/components/uart/uart.h"
+#include "at_parser.h"
+#include "at_command.h"
+#include "command_stats.h"
+
+#include <functional>
+
+#ifndef DFPLAYER_PRO_QUEUE_CAPACITY
+#define DFPLAYER_PRO_QUEUE_CAPACITY 16
+#endif
 
 namespace esphome {
 namespace dfplayer_pro {
 
-#define BUFFER_LENGTH 255
+// Що робити з новою командою, коли черга заповнена (злиття налаштувань спрацьовує раніше)
+enum class OverflowPolicy : uint8_t {
+  DROP_NEWEST,        // відкинути нову команду
+  DROP_OLDEST,        // витіснити найстарішу ще не відправлену
+  REPLACE_SAME_TYPE,  // витіснити найстарішу не відправлену того ж типу; якщо такої немає — відкинути нову
+};
 
 class DFPlayerPro : public esphome::Component, public uart::UARTDevice {
  public:
@@ -16,30 +30,146 @@ class DFPlayerPro : public esphome::Component, public uart::UARTDevice {
   void loop() override;
 
   void init();
-  void send_cmd(const std::string cmd, const std::string value);
+  // Команди повертають false, якщо їх не прийнято в чергу (не ініціалізовано, задовгий аргумент, переповнення)
+  bool send_cmd(const std::string &cmd, const std::string &value);
+
+  // cb — після OK/ERROR/таймауту (або false, якщо команду витіснено з черги); напр. старт алерту на дисплеї
+  bool play_file_no(int no, CommandCallback cb = {});
+  bool play_file(const std::string &file_name);
+  bool set_prompt(bool on_off);
+  bool set_volume(int value);
+  bool set_play_mode(int mode);
+
+  // --- черга ---
+  void set_overflow_policy(OverflowPolicy policy) { this->overflow_policy_ = policy; }
+  // Спрацьовує на кожну відкинуту або витіснену через переповнення команду; аргумент — її тип
+  Trigger<std::string> *get_queue_overflow_trigger() { return this->queue_overflow_trigger_; }
+  static constexpr size_t get_queue_capacity() { return QUEUE_CAPACITY; }
+  size_t get_queue_depth() const { return this->count_; }
+
+  // --- запити стану (асинхронно) ---
+  // Відповідь приходить у cb; якщо значення в кеші не старше max_age_ms — cb викликається одразу, без UART
+  bool query(Query q, ResultCallback cb = {}, uint32_t max_age_ms = 0);
+  // Кешований стан: -1, доки модуль не відповів (або не підтвердив відповідну команду)
+  int get_volume() const { return this->state_.values[static_cast<size_t>(Query::VOLUME)]; }
+  int get_play_mode() const { return this->state_.values[static_cast<size_t>(Query::PLAY_MODE)]; }
+  int get_current_file() const { return this->state_.values[static_cast<size_t>(Query::CURRENT_FILE)]; }
+  int get_total_files() const { return this->state_.values[static_cast<size_t>(Query::TOTAL_FILES)]; }
+  const char *get_file_name() const { return this->state_.file_name; }
+  // Відтворення підтверджене і ще не мало скінчитися: після OK на PLAYNUM/PLAYFILE запитується TOTAL_TIME,
+  // і трек вважається дограним через цю тривалість. Опитування CURRENT_TIME (poll_interval) уточнює старт
+  // і бачить зупинку раніше
+  bool is_playing() const;
+  // 0 = без опитування; інакше раз на інтервал один запит (по колу), лише коли черга порожня
+  void set_poll_interval(uint32_t ms) { this->poll_interval_ms_ = ms; }
 
-  void play_file_no(int no);
-  void play_file(const std::string file_name);
-  void set_prompt(bool on_off);
-  void set_volume(int value);
-  void set_play_mode(int mode);
+  // Джерело часу для таймаутів і обліку черги (емулятор, реплей); за замовчуванням millis()
+  void set_time_source(std::function<uint32_t()> source) { this->time_source_ = std::move(source); }
+
+  // Рядки, що прийшли не як відповідь на активну команду
+  uint32_t get_unsolicited_count() const { return this->unsolicited_count_; }
+  // Планувальник: час від постановки до відправки (мс) і кількість злитих налаштувань
+  uint32_t get_queue_wait_last() const { return this->queue_wait_last_ms_; }
+  uint32_t get_queue_wait_max() const { return this->queue_wait_max_ms_; }
+  uint32_t get_queue_wait_avg() const {
+    return this->sent_count_ ? this->queue_wait_total_ms_ / this->sent_count_ : 0;
+  }
+  uint32_t get_coalesced_count() const { return this->coalesced_count_; }
+  // Телеметрія: лічильники і p50/p99 очікування в черзі та RTT по кожному типу команди (JSON)
+  void get_stats_json(std::string &out) const;
+  const OpcodeStats &get_opcode_stats(Opcode op) const { return this->stats_[static_cast<size_t>(op)]; }
+  uint32_t get_timeout_count() const { return this->timeouts_; }
+  uint32_t get_failed_count() const { return this->failed_; }
+  // Найбільша глибина черги: з останнього reset_stats() і за весь час роботи
+  size_t get_max_queue_depth() const { return this->max_depth_; }
+  size_t get_queue_high_water() const { return this->high_water_; }
+  uint32_t get_overflow_count() const { return this->overflows_; }
+  // Поточний таймаут для типу команди (вивчений з RTT) і чи модуль зараз вважається недоступним
+  uint32_t get_timeout(Opcode op) const { return this->timeout_for_(op); }
+  bool is_degraded() const { return this->degraded_; }
+  void reset_stats();
 
  protected:
-  void send_command(const std::string &cmd, std::function<void(bool)> cb = nullptr);
+  // Кладе команду в пул; false, якщо пул заповнено або аргумент задовгий
+  bool send_command(Opcode op, int32_t num = 0, const char *arg = nullptr, CommandCallback cb = {});
+
  private:
-  struct PendingCommand {
-    std::string cmd;
-    std::function<void(bool)> callback;
-    uint32_t start_time;
-    bool sent{false};
-  };
-
-  std::deque<PendingCommand> queue_;
-  PendingCommand *active_{nullptr};
-  std::string response_buffer_;
-  const uint32_t timeout_ms_ = 1000;
+  static constexpr size_t QUEUE_CAPACITY = DFPLAYER_PRO_QUEUE_CAPACITY;
+
+  // Фіксований пул слотів; наступну команду обирає next_command_() за (пріоритет, seq)
+  Command pool_[QUEUE_CAPACITY];
+  size_t count_{0};
+  uint32_t next_seq_{0};
+  Command *active_{nullptr};
+  uint32_t queue_wait_last_ms_{0};
+  uint32_t queue_wait_max_ms_{0};
+  uint32_t queue_wait_total_ms_{0};
+  uint32_t sent_count_{0};
+  uint32_t coalesced_count_{0};
+  OpcodeStats stats_[OPCODE_COUNT];
+  uint32_t timeouts_{0};
+  uint32_t failed_{0};
+  size_t max_depth_{0};
+  size_t high_water_{0};
+  uint32_t overflows_{0};
+  OverflowPolicy overflow_policy_{OverflowPolicy::DROP_NEWEST};
+  Trigger<std::string> *queue_overflow_trigger_{new Trigger<std::string>()};
+  char tx_buffer_[BUFFER_LENGTH + 1]{};
+  AtLineParser parser_;
+  std::function<uint32_t()> time_source_;
+  uint32_t unsolicited_count_{0};
+  const uint32_t timeout_ms_ = 1000;  // стеля таймауту і значення, доки RTT ще не вивчено
+
+  // Адаптивні таймаути, повтори і відновлення
+  static constexpr uint32_t MIN_TIMEOUT_MS = 200;
+  static constexpr uint32_t TIMEOUT_P99_FACTOR = 4;
+  static constexpr uint32_t TIMEOUT_MIN_SAMPLES = 8;
+  static constexpr uint8_t MAX_RETRIES = 2;
+  static constexpr uint32_t RETRY_BACKOFF_MS = 100;  // 100, 200, ...
+  static constexpr uint8_t REINIT_AFTER_TIMEOUTS = 3;
+  static constexpr uint32_t REINIT_MIN_INTERVAL_MS = 10000;
+  uint8_t consecutive_timeouts_{0};
+  bool degraded_{false};
+  uint32_t last_reinit_{0};
+  uint32_t retries_{0};
+  uint32_t reinits_{0};
+
+  // Кеш стану модуля: значення за Query + час оновлення
+  struct DeviceState {
+    int32_t values[static_cast<size_t>(Query::COUNT)];
+    uint32_t updated[static_cast<size_t>(Query::COUNT)]{};
+    char file_name[Command::ARG_LENGTH]{};
+    bool playing{false};
+    uint32_t play_started{0};  // момент початку треку (OK на відтворення або з CURRENT_TIME)
+    DeviceState() { std::fill_n(this->values, static_cast<size_t>(Query::COUNT), -1); }
+  } state_;
+  uint32_t poll_interval_ms_{0};
+  uint32_t last_poll_{0};
+  uint8_t poll_index_{0};
 
+  uint32_t now_() const { return this->time_source_ ? this->time_source_() : millis(); }
+  // Слот нової (або злитої) команди; nullptr, якщо не влізла
+  Command *enqueue_(Opcode op, int32_t num = 0, const char *arg = nullptr, CommandCallback cb = {});
+  Command *next_command_();
+  // Звільняє місце за політикою переповнення; false — нову команду треба відкинути
+  bool make_room_(Opcode op);
+  // Прибирає з черги ще не відправлену команду; її колбек отримує false
+  void evict_(Command &c);
   void process_active();
+  void handle_line_();
+  enum class Outcome : uint8_t { OK, FAILED, TIMEOUT };
+  void complete_active_(Outcome outcome, const char *reply = nullptr);
+  uint32_t timeout_for_(Opcode op) const;
+  void check_recovery_();
+  void record_outcome_(const Command &done, Outcome outcome);
+  void update_state_(Query q, int32_t value, const char *text);
+  // Новий трек: скидає час і тривалість попереднього і ставить запит TOTAL_TIME
+  void track_started_();
+  // TOTAL_TIME — цілі секунди; запас, щоб не вважати трек дограним на долю секунди раніше
+  static constexpr uint32_t PLAY_END_SLACK_MS = 1000;
+  // CURRENT_TIME=0 одразу після старту ще не означає зупинку
+  static constexpr uint32_t PLAY_START_GRACE_MS = 1500;
+  void poll_();
   bool initialized_{false};
 };
 
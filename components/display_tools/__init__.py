@@ -4,10 +4,25 @@ from esphome.components import time
 from esphome import automation
 from esphome.const import CONF_ID
 
+DEPENDENCIES = ["font"]
 CODEOWNERS = ["@10der"]
 
 CONF_CLOCK_TIME = "clock_time"
 CONF_ON_PLAY_SOUND = "on_play_sound"
+CONF_PERSIST_APPS = "persist_apps"
+CONF_SNAPSHOT_INTERVAL = "snapshot_interval"
+CONF_SNAPSHOT_SIZE = "snapshot_size"
+CONF_GAMMA = "gamma"
+CONF_BRIGHTNESS = "brightness"
+CONF_NIGHT_UPDATE_INTERVAL = "night_update_interval"
+CONF_NIGHT_LEVEL = "night_level"
+CONF_BOOT_FRAME = "boot_frame"
+CONF_BOOT_FRAME_INTERVAL = "boot_frame_interval"
+CONF_FRAME_TRACE = "frame_trace"
+CONF_REPLAY_FRAME_STEP = "replay_frame_step"
+CONF_REPLAY_EPOCH = "replay_epoch"
+CONF_SOUND_SYNC_TIMEOUT = "sound_sync_timeout"
+CONF_MEMORY_BUDGET = "memory_budget"
 
 display_tools_ns = cg.esphome_ns.namespace("display_tools")
 DisplayTools = display_tools_ns.class_("DisplayTools", cg.Component)
@@ -16,6 +31,22 @@ CONFIG_SCHEMA = cv.Schema({
     cv.GenerateID(): cv.declare_id(DisplayTools),
     cv.Optional(CONF_CLOCK_TIME): cv.use_id(time.RealTimeClock),
     cv.Optional(CONF_ON_PLAY_SOUND): automation.validate_automation(single=True),
+    cv.Optional(CONF_PERSIST_APPS, default=False): cv.boolean,
+    cv.Optional(CONF_SNAPSHOT_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_SNAPSHOT_SIZE, default=8192): cv.int_range(min=256, max=65536),
+    cv.Optional(CONF_GAMMA, default=2.2): cv.float_range(min=0.5, max=4.0),
+    # Має збігатися з brightness дисплея: палітра рахує поріг видимості від неї, доки number не опублікує свою
+    cv.Optional(CONF_BRIGHTNESS, default=255): cv.int_range(min=0, max=255),
+    cv.Optional(CONF_NIGHT_UPDATE_INTERVAL): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_NIGHT_LEVEL, default=160): cv.int_range(min=1, max=255),
+    cv.Optional(CONF_BOOT_FRAME, default=False): cv.boolean,
+    cv.Optional(CONF_BOOT_FRAME_INTERVAL, default="10min"): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_FRAME_TRACE, default=False): cv.boolean,
+    cv.Optional(CONF_REPLAY_FRAME_STEP): cv.positive_time_period_milliseconds,
+    cv.Optional(CONF_REPLAY_EPOCH): cv.positive_int,
+    cv.Optional(CONF_SOUND_SYNC_TIMEOUT, default="0ms"): cv.positive_time_period_milliseconds,
+    # Оцінка байтів на apps і їхні бітмапи (черга алертів має свою межу); 0 = без обмеження
+    cv.Optional(CONF_MEMORY_BUDGET, default=0): cv.int_range(min=0),
 })
 
 async def to_code(config):
@@ -26,6 +57,25 @@ async def to_code(config):
         clk = await cg.get_variable(config[CONF_CLOCK_TIME])
         cg.add(var.set_clock_time(clk))
 
+    cg.add(var.set_persist_apps(config[CONF_PERSIST_APPS]))
+    cg.add(var.set_snapshot_interval(config[CONF_SNAPSHOT_INTERVAL]))
+    cg.add_define("DISPLAY_TOOLS_SNAPSHOT_SIZE", config[CONF_SNAPSHOT_SIZE])
+    cg.add(var.set_gamma(config[CONF_GAMMA]))
+    cg.add(var.set_brightness(config[CONF_BRIGHTNESS]))
+    cg.add(var.set_night_level(config[CONF_NIGHT_LEVEL]))
+    if CONF_NIGHT_UPDATE_INTERVAL in config:
+        cg.add(var.set_night_update_interval(config[CONF_NIGHT_UPDATE_INTERVAL]))
+    cg.add(var.set_boot_frame(config[CONF_BOOT_FRAME]))
+    cg.add(var.set_boot_frame_interval(config[CONF_BOOT_FRAME_INTERVAL]))
+    cg.add(var.set_frame_trace(config[CONF_FRAME_TRACE]))
+    if CONF_REPLAY_FRAME_STEP in config:
+        cg.add(var.set_replay_frame_step(config[CONF_REPLAY_FRAME_STEP]))
+    if CONF_REPLAY_EPOCH in config:
+        cg.add(var.set_replay_epoch(config[CONF_REPLAY_EPOCH]))
+
+    cg.add(var.set_sound_sync_timeout(config[CONF_SOUND_SYNC_TIMEOUT]))
+    cg.add(var.set_memory_budget(config[CONF_MEMORY_BUDGET]))
+
     if CONF_ON_PLAY_SOUND in config:
         await automation.build_automation(
             var.get_on_play_trigger(), [(cg.int_, "x")], config[CONF_ON_PLAY_SOUND]
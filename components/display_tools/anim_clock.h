@@ -0,0 +1,116 @@
+// anim_clock.h
+#pragma once
+
+#include "esphome.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// AnimationClock: один монотонний годинник для всіх анімацій DisplayTools.
+// tick() раз на кадр фіксує час кадру і дельту; усі малювалки в межах кадру
+// бачать той самий час. Джерело часу підміняється (тести, реплей).
+// Для детермінованого реплею: фіксований крок кадру і зафіксована епоха настінного часу.
+// Статистика пейсингу: гістограма інтервалів між кадрами (p50/p99) і пропущені кроки скролу.
+// ============================================================================
+class AnimationClock {
+ public:
+  using TimeSource = std::function<uint32_t()>;
+
+  void set_time_source(TimeSource source) { this->source_ = std::move(source); }
+  uint32_t now() const { return this->source_ ? this->source_() : millis(); }
+
+  // step_ms > 0: кожен tick() просуває час рівно на step_ms, незалежно від реального часу
+  void set_fixed_step(uint32_t step_ms) { this->fixed_step_ms_ = step_ms; }
+  // epoch > 0: настінний час = epoch + frame_time / 1000 (годинник на екрані не залежить від хоста)
+  void set_epoch(time_t epoch) { this->epoch_ = epoch; }
+  time_t wall_time() const {
+    return this->epoch_ > 0 ? this->epoch_ + static_cast<time_t>(this->frame_time_ / 1000) : ::time(nullptr);
+  }
+
+  void tick() {
+    uint32_t t;
+    if (this->fixed_step_ms_ > 0)
+      t = this->started_ ? this->frame_time_ + this->fixed_step_ms_ : 0;
+    else
+      t = this->now();
+    uint32_t delta = this->started_ ? t - this->frame_time_ : 0;
+    if (this->started_) {
+      this->interval_hist_[std::min<uint32_t>(delta, INTERVAL_BUCKETS - 1)]++;
+      this->interval_count_++;
+    }
+    // Зависання (WiFi, MQTT) лише рахуємо: дельта лишається справжньою, тож скрол після нього
+    // йде за настінним часом, а пропущене видно в skipped_steps
+    if (delta > STALL_MS)
+      this->stalls_++;
+    this->frame_delta_ = delta;
+    this->frame_time_ = t;
+    this->started_ = true;
+  }
+  uint32_t frame_time() const { return this->frame_time_; }
+  uint32_t frame_delta() const { return this->frame_delta_; }
+
+  // Плановий інтервал кадрів (update_interval дисплея): від нього рахуються пропущені кроки
+  void set_nominal_interval(uint32_t ms) { this->nominal_interval_ms_ = ms; }
+
+  // Фіксований крок: накопичуємо дельту кадру, віддаємо цілу кількість кроків, залишок зберігаємо.
+  // Кроки наздоганяються повністю; усе понад плановий темп за кадр рахуємо як пропущені (видимий ривок)
+  int steps(uint32_t &accum_ms, uint32_t step_ms) {
+    accum_ms += this->frame_delta_;
+    const uint32_t n = accum_ms / step_ms;
+    accum_ms -= n * step_ms;
+    const uint32_t expected = std::max<uint32_t>(1, (this->nominal_interval_ms_ + step_ms - 1) / step_ms);
+    if (n > expected)
+      this->skipped_steps_ += n - expected;
+    return static_cast<int>(n);
+  }
+
+  // --- статистика пейсингу (накопичується до reset_stats) ---
+  // Інтервал між кадрами в мс, нижче якого лежить pct% кадрів; останній кошик = ">= 63 мс"
+  uint32_t interval_percentile(uint8_t pct) const {
+    if (this->interval_count_ == 0)
+      return 0;
+    const uint32_t target = (this->interval_count_ * pct + 99) / 100;
+    uint32_t seen = 0;
+    for (uint32_t ms = 0; ms < INTERVAL_BUCKETS; ms++) {
+      seen += this->interval_hist_[ms];
+      if (seen >= target)
+        return ms;
+    }
+    return INTERVAL_BUCKETS - 1;
+  }
+  uint32_t interval_count() const { return this->interval_count_; }
+  uint32_t skipped_steps() const { return this->skipped_steps_; }
+  uint32_t stalls() const { return this->stalls_; }
+  void reset_stats() {
+    this->interval_hist_.fill(0);
+    this->interval_count_ = 0;
+    this->skipped_steps_ = 0;
+    this->stalls_ = 0;
+  }
+
+ protected:
+  TimeSource source_;
+  uint32_t frame_time_{0};
+  uint32_t frame_delta_{0};
+  bool started_{false};
+  uint32_t fixed_step_ms_{0};
+  time_t epoch_{0};
+  uint32_t nominal_interval_ms_{0};
+
+  static constexpr uint32_t STALL_MS = 250;
+  static constexpr uint32_t INTERVAL_BUCKETS = 64;  // по 1 мс
+  std::array<uint32_t, INTERVAL_BUCKETS> interval_hist_{};
+  uint32_t interval_count_{0};
+  uint32_t skipped_steps_{0};
+  uint32_t stalls_{0};
+};
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,80 @@
+// app_arena.cpp
+#include "app_arena.h"
+
+#include <algorithm>
+#include <new>
+
+namespace esphome {
+namespace display_tools {
+
+static const char *const TAG = "app_arena";
+
+const size_t PayloadArena::BLOCK_HEADER = PayloadArena::footprint(sizeof(PayloadArena::Block));
+const size_t PayloadArena::ARENA_HEADER = PayloadArena::footprint(sizeof(PayloadArena));
+
+PayloadArena *PayloadArena::create(ArenaBacking *backing, size_t size) {
+  Block *block = new_block_(backing, BLOCK_HEADER + ARENA_HEADER + footprint(size));
+  auto *arena = new (reinterpret_cast<uint8_t *>(block) + BLOCK_HEADER) PayloadArena(backing);
+  arena->first_ = block;
+  arena->cur_ = reinterpret_cast<uint8_t *>(block) + BLOCK_HEADER + ARENA_HEADER;
+  arena->end_ = reinterpret_cast<uint8_t *>(block) + block->size;
+  arena->reserved_ = block->size;
+  arena->blocks_ = 1;
+  return arena;
+}
+
+void *PayloadArena::allocate(size_t size, size_t align) {
+  auto aligned = [align](uint8_t *p) {
+    return reinterpret_cast<uint8_t *>((reinterpret_cast<uintptr_t>(p) + align - 1) & ~(uintptr_t) (align - 1));
+  };
+  uint8_t *p = aligned(this->cur_);
+  if (p > this->end_ || static_cast<size_t>(this->end_ - p) < size) {
+    Block *block = new_block_(this->backing_, std::max(BLOCK_HEADER + footprint(size + align), SPILL_BLOCK_SIZE));
+    block->next = this->spill_;
+    this->spill_ = block;
+    this->cur_ = reinterpret_cast<uint8_t *>(block) + BLOCK_HEADER;
+    this->end_ = reinterpret_cast<uint8_t *>(block) + block->size;
+    this->reserved_ += block->size;
+    this->blocks_++;
+    p = aligned(this->cur_);
+  }
+  this->cur_ = p + size;
+  this->used_ += size;
+  return p;
+}
+
+PayloadArena::Block *PayloadArena::new_block_(ArenaBacking *backing, size_t size) {
+  uint8_t *mem = backing != nullptr ? backing->allocate(size) : nullptr;
+  const bool heap = mem == nullptr;
+  if (heap) {
+    ESP_LOGW(TAG, "Backing has no %u bytes for app payload, using heap", (unsigned) size);
+    mem = new uint8_t[size];
+  }
+  auto *block = reinterpret_cast<Block *>(mem);
+  block->next = nullptr;
+  block->size = size;
+  block->heap = heap;
+  return block;
+}
+
+void PayloadArena::free_block_(ArenaBacking *backing, Block *block) {
+  if (block->heap)
+    delete[] reinterpret_cast<uint8_t *>(block);
+  else
+    backing->release(reinterpret_cast<uint8_t *>(block), block->size);
+}
+
+void PayloadArena::destroy_(PayloadArena *arena) {
+  ArenaBacking *backing = arena->backing_;
+  Block *first = arena->first_;
+  for (Block *block = arena->spill_; block != nullptr;) {
+    Block *next = block->next;
+    free_block_(backing, block);
+    block = next;
+  }
+  arena->~PayloadArena();
+  free_block_(backing, first);
+}
+
+}  // namespace display_tools
+}  // namespace esphome
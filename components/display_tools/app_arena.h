@@ -0,0 +1,207 @@
+// app_arena.h
+#pragma once
+
+#include "esphome.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// Пам'ять під вантаж apps з обраного сховища (купа/PSRAM), що звільняється цілими блоками:
+//  - PayloadArena + PayloadAllocator: рядки, частини тексту і команди малювання одного app;
+//  - AppArena: блок точного розміру під одну бітмапу (спільні бітмапи — у BitmapStore).
+// ============================================================================
+
+// Звідки брати блок арени: купа, PSRAM або власне сховище (хост-тести)
+class ArenaBacking {
+ public:
+  virtual ~ArenaBacking() = default;
+  virtual uint8_t *allocate(size_t size) = 0;
+  virtual void release(uint8_t *ptr, size_t size) = 0;
+};
+
+// Через RAMAllocator ESPHome: з external спершу PSRAM, без неї (або коли вона повна) — внутрішня RAM
+class RamArenaBacking : public ArenaBacking {
+ public:
+  explicit RamArenaBacking(bool external)
+      : allocator_(external ? (RAMAllocator<uint8_t>::ALLOC_EXTERNAL | RAMAllocator<uint8_t>::ALLOC_INTERNAL)
+                            : RAMAllocator<uint8_t>::ALLOC_INTERNAL) {}
+  uint8_t *allocate(size_t size) override { return this->allocator_.allocate(size); }
+  void release(uint8_t *ptr, size_t size) override { this->allocator_.deallocate(ptr, size); }
+
+ protected:
+  RAMAllocator<uint8_t> allocator_;
+};
+
+// Bump-арена фіксованої ємності: розмір відомий наперед
+class AppArena {
+ public:
+  AppArena(ArenaBacking *backing, size_t capacity) : backing_(backing) {
+    if (capacity > 0 && backing != nullptr)
+      this->data_ = backing->allocate(capacity);
+    this->capacity_ = this->data_ != nullptr ? capacity : 0;
+  }
+  ~AppArena() {
+    if (this->data_ != nullptr)
+      this->backing_->release(this->data_, this->capacity_);
+  }
+  AppArena(const AppArena &) = delete;
+  AppArena &operator=(const AppArena &) = delete;
+
+  bool ok() const { return this->data_ != nullptr; }
+  size_t capacity() const { return this->capacity_; }
+  size_t used() const { return this->used_; }
+  const uint8_t *data() const { return this->data_; }
+
+  // Копія даних в арену; nullptr, якщо не вистачає місця
+  const uint8_t *copy(const uint8_t *src, size_t size) {
+    if (this->data_ == nullptr || this->capacity_ - this->used_ < size)
+      return nullptr;
+    uint8_t *dst = this->data_ + this->used_;
+    memcpy(dst, src, size);
+    this->used_ += size;
+    return dst;
+  }
+
+ protected:
+  ArenaBacking *backing_;
+  uint8_t *data_{nullptr};
+  size_t capacity_{0};
+  size_t used_{0};
+};
+
+// ============================================================================
+// PayloadArena: монотонна арена вантажу одного app. Перший блок (разом із самою ареною)
+// береться під уже підрахований розмір вантажу; що не влізло (patch подовжив рядок) — у
+// додаткові блоки. Окремі звільнення лише рахуються, а блоки повертаються в backing разом,
+// коли арену відпускає останній контейнер, тобто коли app оновили або видалили.
+// Лічильник посилань не атомарний: apps живуть лише в циклі ESPHome.
+// ============================================================================
+class PayloadArena {
+ public:
+  // Арена з першим блоком на size байтів вантажу (див. footprint)
+  static PayloadArena *create(ArenaBacking *backing, size_t size);
+  PayloadArena(const PayloadArena &) = delete;
+  PayloadArena &operator=(const PayloadArena &) = delete;
+
+  void *allocate(size_t size, size_t align);
+  void deallocate(void *ptr, size_t size) { this->freed_ += size; }
+
+  void retain() { this->refs_++; }
+  void release() {
+    if (--this->refs_ == 0)
+      destroy_(this);
+  }
+
+  // Байтів узято з backing (з заголовками блоків і самою ареною)
+  size_t reserved() const { return this->reserved_; }
+  // Видано контейнерам; з них уже не потрібні (замінені рядки, старі буфери векторів)
+  size_t used() const { return this->used_; }
+  size_t freed() const { return this->freed_; }
+  size_t blocks() const { return this->blocks_; }
+
+  static constexpr size_t ALIGN = alignof(std::max_align_t);
+  // Місце під виділення size байтів з вирівнюванням ALIGN
+  static constexpr size_t footprint(size_t size) { return (size + ALIGN - 1) & ~(ALIGN - 1); }
+
+ protected:
+  struct Block {
+    Block *next;
+    size_t size;  // разом із заголовком
+    bool heap;    // backing не дав пам'яті — блок із загальної купи
+  };
+  static constexpr size_t SPILL_BLOCK_SIZE = 128;
+  static const size_t BLOCK_HEADER;
+  static const size_t ARENA_HEADER;
+
+  explicit PayloadArena(ArenaBacking *backing) : backing_(backing) {}
+  ~PayloadArena() = default;
+  static Block *new_block_(ArenaBacking *backing, size_t size);
+  static void free_block_(ArenaBacking *backing, Block *block);
+  static void destroy_(PayloadArena *arena);
+
+  ArenaBacking *backing_;
+  Block *first_{nullptr};  // у ньому лежить сама арена
+  Block *spill_{nullptr};
+  uint8_t *cur_{nullptr};
+  uint8_t *end_{nullptr};
+  size_t reserved_{0};
+  size_t used_{0};
+  size_t freed_{0};
+  size_t blocks_{0};
+  uint32_t refs_{0};
+};
+
+// Алокатор контейнерів вантажу, на кшталт std::pmr::polymorphic_allocator: з ареною — з неї,
+// без арени (за замовчуванням) — загальна купа. Тримає арену живою. Переміщення контейнера
+// забирає арену з собою, а копія контейнера йде в купу, тож копії apps не тримають чужих арен.
+template<typename T> class PayloadAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::false_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  PayloadAllocator() = default;
+  explicit PayloadAllocator(PayloadArena *arena) : arena_(arena) {
+    if (this->arena_ != nullptr)
+      this->arena_->retain();
+  }
+  PayloadAllocator(const PayloadAllocator &other) : PayloadAllocator(other.arena_) {}
+  template<typename U> PayloadAllocator(const PayloadAllocator<U> &other) : PayloadAllocator(other.arena()) {}
+  PayloadAllocator &operator=(PayloadAllocator other) {
+    std::swap(this->arena_, other.arena_);
+    return *this;
+  }
+  ~PayloadAllocator() {
+    if (this->arena_ != nullptr)
+      this->arena_->release();
+  }
+
+  T *allocate(size_t n) {
+    if (this->arena_ == nullptr)
+      return std::allocator<T>().allocate(n);
+    return static_cast<T *>(this->arena_->allocate(n * sizeof(T), alignof(T)));
+  }
+  void deallocate(T *ptr, size_t n) {
+    if (this->arena_ == nullptr)
+      std::allocator<T>().deallocate(ptr, n);
+    else
+      this->arena_->deallocate(ptr, n * sizeof(T));
+  }
+  PayloadAllocator select_on_container_copy_construction() const { return PayloadAllocator(); }
+
+  PayloadArena *arena() const { return this->arena_; }
+
+ protected:
+  PayloadArena *arena_{nullptr};
+};
+
+template<typename T, typename U> bool operator==(const PayloadAllocator<T> &a, const PayloadAllocator<U> &b) {
+  return a.arena() == b.arena();
+}
+template<typename T, typename U> bool operator!=(const PayloadAllocator<T> &a, const PayloadAllocator<U> &b) {
+  return a.arena() != b.arena();
+}
+
+using PayloadString = std::basic_string<char, std::char_traits<char>, PayloadAllocator<char>>;
+template<typename T> using PayloadVector = std::vector<T, PayloadAllocator<T>>;
+
+// Скільки арени займе рядок довжини len; короткий рядок живе в самому об'єкті (SSO).
+// Рядки не вирівнюються, тож підряд вони лягають впритул
+inline size_t payload_string_footprint(size_t len) {
+  static const size_t local = PayloadString().capacity();
+  return len > local ? len + 1 : 0;
+}
+
+}  // namespace display_tools
+}  // namespace esphome
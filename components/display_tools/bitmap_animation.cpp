@@ -0,0 +1,144 @@
+// bitmap_animation.cpp
+#include "bitmap_animation.h"
+
+#include <cstring>
+
+namespace esphome {
+namespace display_tools {
+
+static const char *const TAG = "bitmap_animation";
+
+uint32_t BitmapAnimation::next_id_ = 0;
+
+void BitmapAnimation::add_frame(uint16_t duration_ms) {
+  if (this->frames_.empty()) {
+    this->frames_.push_back({0, duration_ms});
+  } else {
+    this->frames_.push_back({static_cast<uint32_t>(this->staging_.size()), duration_ms});
+    this->staging_.push_back(0);  // кількість прямокутників кадру, росте в add_rect
+  }
+  this->total_ms_ += duration_ms;
+}
+
+bool BitmapAnimation::add_rect(int x, int y, int w, int h, const uint8_t *rgb, size_t size) {
+  if (this->frames_.size() < 2 || x < 0 || y < 0 || x > 255 || y > 255 || w <= 0 || h <= 0 || w > 255 || h > 255)
+    return false;
+  if (size != static_cast<size_t>(w * h * 3))
+    return false;
+  uint8_t &rects = this->staging_[this->frames_.back().offset];
+  if (rects == MAX_RECTS_PER_FRAME)
+    return false;
+  rects++;
+  this->staging_.push_back(x);
+  this->staging_.push_back(y);
+  this->staging_.push_back(w);
+  this->staging_.push_back(h);
+  this->staging_.insert(this->staging_.end(), rgb, rgb + size);
+  return true;
+}
+
+void BitmapAnimation::load(std::vector<uint16_t> durations, std::vector<uint8_t> stream) {
+  this->frames_.clear();
+  this->total_ms_ = 0;
+  for (uint16_t d : durations) {
+    this->frames_.push_back({0, d});  // зміщення кадрів порахує adopt()
+    this->total_ms_ += d;
+  }
+  this->staging_ = std::move(stream);
+  this->stream_.reset();
+}
+
+bool BitmapAnimation::adopt(BitmapStore &store, int width, int height) {
+  if (this->stream_ != nullptr && this->staging_.empty())
+    return true;  // уже у сховищі (той самий DrawObject повторно)
+
+  const uint8_t *data = this->staging_.data();
+  const size_t size = this->staging_.size();
+  size_t pos = 0;
+  bool valid = true;
+  for (size_t i = 1; i < this->frames_.size() && valid; i++) {
+    if (pos >= size) {
+      valid = false;
+      break;
+    }
+    this->frames_[i].offset = pos;
+    const uint8_t rects = data[pos++];
+    for (uint8_t r = 0; r < rects; r++) {
+      if (size - pos < 4) {
+        valid = false;
+        break;
+      }
+      const int x = data[pos], y = data[pos + 1], w = data[pos + 2], h = data[pos + 3];
+      pos += 4;
+      const size_t n = static_cast<size_t>(w * h * 3);
+      if (w == 0 || h == 0 || x + w > width || y + h > height || size - pos < n) {
+        valid = false;
+        break;
+      }
+      pos += n;
+    }
+  }
+  if (valid && pos != size)
+    valid = false;
+
+  if (valid && size > 0) {
+    this->stream_ = store.intern(data, size);
+    if (this->stream_ == nullptr)
+      ESP_LOGW(TAG, "No memory for %u-byte animation stream, showing keyframe only", (unsigned) size);
+  } else if (!valid) {
+    ESP_LOGW(TAG, "Invalid animation stream for %dx%d bitmap (%u frames), showing keyframe only", width, height,
+             (unsigned) this->frames_.size());
+  }
+  std::vector<uint8_t>().swap(this->staging_);
+  if (!valid || (size > 0 && this->stream_ == nullptr)) {
+    if (this->frames_.size() > 1)
+      this->frames_.resize(1);
+    this->total_ms_ = this->frames_.empty() ? 0 : this->frames_[0].duration_ms;
+    this->frames_.shrink_to_fit();
+    return false;
+  }
+  this->frames_.shrink_to_fit();
+  this->width_ = width;
+  return true;
+}
+
+size_t BitmapAnimation::frame_at(uint32_t ms) const {
+  if (this->frames_.size() < 2 || this->total_ms_ == 0)
+    return 0;
+  uint32_t t = ms % this->total_ms_;
+  for (size_t i = 0; i < this->frames_.size(); i++) {
+    if (t < this->frames_[i].duration_ms)
+      return i;
+    t -= this->frames_[i].duration_ms;
+  }
+  return this->frames_.size() - 1;
+}
+
+void HOT BitmapAnimation::apply(size_t index, uint8_t *rgb) const {
+  if (this->stream_ == nullptr || index == 0 || index >= this->frames_.size())
+    return;
+  const uint8_t *p = this->stream_->data() + this->frames_[index].offset;
+  const uint8_t rects = *p++;
+  for (uint8_t r = 0; r < rects; r++) {
+    const int x = p[0], y = p[1], w = p[2], h = p[3];
+    p += 4;
+    const size_t row_bytes = static_cast<size_t>(w) * 3;
+    for (int row = 0; row < h; row++, p += row_bytes)
+      memcpy(rgb + (static_cast<size_t>(y + row) * this->width_ + x) * 3, p, row_bytes);
+  }
+}
+
+const uint8_t *BitmapAnimation::stream_data() const {
+  return this->stream_ != nullptr ? this->stream_->data() : this->staging_.data();
+}
+
+size_t BitmapAnimation::stream_size() const {
+  return this->stream_ != nullptr ? this->stream_->used() : this->staging_.size();
+}
+
+size_t BitmapAnimation::bytes() const {
+  return sizeof(BitmapAnimation) + this->frames_.capacity() * sizeof(Frame) + this->staging_.capacity();
+}
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,71 @@
+// bitmap_animation.h
+#pragma once
+
+#include "esphome.h"
+#include "bitmap_store.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// BitmapAnimation: кадри анімованої бітмапи (DrawCommandType::ANIMATION).
+// Кадр 0 — ключовий, це звичайна бітмапа DrawObject (дані або хеш у сховищі).
+// Кожен наступний кадр — лише змінені прямокутники відносно попереднього:
+//   кадр  = rects:u8 | rect*
+//   rect  = x:u8 y:u8 w:u8 h:u8 | rgb[w*h*3]
+// Потік змін після addApp лежить у BitmapStore; кадр розгортається на вимогу
+// в робочий буфер DisplayTools (animation_frame_).
+// ============================================================================
+class BitmapAnimation {
+ public:
+  static constexpr uint8_t MAX_RECTS_PER_FRAME = 255;
+
+  // --- Збирання (YAML, знімок), до addApp ---
+  // Перший виклик описує ключовий кадр, кожен наступний відкриває кадр змін
+  void add_frame(uint16_t duration_ms);
+  // Змінений прямокутник останнього кадру; false — це ключовий кадр, завеликий прямокутник
+  // або не той розмір rgb (size має бути w*h*3)
+  bool add_rect(int x, int y, int w, int h, const uint8_t *rgb, size_t size);
+  // Готовий потік змін (знімок): тривалості всіх кадрів і кадри 1..n-1 у форматі вище
+  void load(std::vector<uint16_t> durations, std::vector<uint8_t> stream);
+
+  // Перевіряє потік під бітмапу width x height і переносить його у сховище.
+  // false — потік пошкоджений або немає пам'яті (тоді показується лише ключовий кадр)
+  bool adopt(BitmapStore &store, int width, int height);
+
+  size_t frame_count() const { return this->frames_.size(); }
+  uint16_t frame_duration(size_t index) const { return this->frames_[index].duration_ms; }
+  uint32_t total_ms() const { return this->total_ms_; }
+  // Кадр, що показується через ms від початку показу (по колу)
+  size_t frame_at(uint32_t ms) const;
+  // Накладає зміни кадру index (1..n-1) на розгорнутий попередній кадр
+  void apply(size_t index, uint8_t *rgb) const;
+
+  // Унікальний номер екземпляра: робочий буфер перевіряє, чий кадр у ньому лежить
+  uint32_t id() const { return this->id_; }
+  const BitmapStore::Ref &stream() const { return this->stream_; }
+  const uint8_t *stream_data() const;
+  size_t stream_size() const;
+  // Пам'ять поза сховищем (таблиця кадрів і ще не перенесений потік)
+  size_t bytes() const;
+
+ protected:
+  struct Frame {
+    uint32_t offset;  // початок кадру в потоці (для кадру 0 не використовується)
+    uint16_t duration_ms;
+  };
+
+  static uint32_t next_id_;
+  uint32_t id_{++next_id_};
+  std::vector<Frame> frames_;
+  std::vector<uint8_t> staging_;  // потік до adopt()
+  BitmapStore::Ref stream_;
+  int width_{0};
+  uint32_t total_ms_{0};
+};
+
+}  // namespace display_tools
+}  // namespace esphome
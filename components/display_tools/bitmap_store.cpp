@@ -0,0 +1,84 @@
+// bitmap_store.cpp
+#include "bitmap_store.h"
+#include "snapshot.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace display_tools {
+
+static const char *const TAG = "bitmap_store";
+
+BitmapStore::Ref BitmapStore::intern(const uint8_t *data, size_t size, uint32_t *hash) {
+  const uint32_t h = snapshot_crc32(data, size);
+  if (hash != nullptr)
+    *hash = h;
+
+  bool shared = true;
+  auto it = this->blocks_.find(h);
+  if (it != this->blocks_.end()) {
+    Ref found = it->second.lock();
+    if (found != nullptr) {
+      if (found->used() == size && memcmp(found->data(), data, size) == 0) {
+        this->dedup_hits_++;
+        this->dedup_bytes_ += size;
+        return found;
+      }
+      // Колізія CRC: окрема копія поза таблицею, хеш лишається за першою бітмапою
+      ESP_LOGW(TAG, "Bitmap hash %08x collides with a different bitmap, storing unshared copy", (unsigned) h);
+      shared = false;
+    }
+  }
+
+  auto *block = new AppArena(this->backing_, size);
+  if (!block->ok() || block->copy(data, size) == nullptr) {
+    delete block;
+    return nullptr;
+  }
+  Ref ref(block, [this, h, shared](const AppArena *b) { this->release_(h, shared, const_cast<AppArena *>(b)); });
+  if (shared) {
+    this->blocks_[h] = ref;
+    this->generation_++;
+  }
+  this->bytes_ += size;
+  return ref;
+}
+
+BitmapStore::Ref BitmapStore::find(uint32_t hash) const {
+  auto it = this->blocks_.find(hash);
+  return it != this->blocks_.end() ? it->second.lock() : nullptr;
+}
+
+void BitmapStore::release_(uint32_t hash, bool shared, AppArena *block) {
+  this->bytes_ -= block->used();
+  if (shared) {
+    auto it = this->blocks_.find(hash);
+    // запис міг уже зайняти новий блок з тим самим хешем — видаляємо лише свій
+    if (it != this->blocks_.end() && it->second.expired()) {
+      this->blocks_.erase(it);
+      this->generation_++;
+    }
+  }
+  delete block;
+}
+
+void BitmapStore::get_json(std::string &out) const {
+  char buf[96];
+  snprintf(buf, sizeof(buf), "{\"count\":%u,\"bytes\":%u,\"hits\":%u,\"saved\":%u,\"hashes\":[",
+           (unsigned) this->blocks_.size(), (unsigned) this->bytes_, (unsigned) this->dedup_hits_,
+           (unsigned) this->dedup_bytes_);
+  out.clear();
+  out.reserve(strlen(buf) + this->blocks_.size() * 11 + 2);
+  out += buf;
+  bool first = true;
+  for (const auto &kv : this->blocks_) {
+    snprintf(buf, sizeof(buf), "%s\"%08x\"", first ? "" : ",", (unsigned) kv.first);
+    out += buf;
+    first = false;
+  }
+  out += "]}";
+}
+
+}  // namespace display_tools
+}  // namespace esphome
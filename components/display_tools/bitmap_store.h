@@ -0,0 +1,61 @@
+// bitmap_store.h
+#pragma once
+
+#include "esphome.h"
+#include "app_arena.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// BitmapStore: бітмапи apps за вмістом. Однакова бітмапа зберігається один раз,
+// apps тримають на неї посилання (shared_ptr); блок звільняється з останнім посиланням.
+// Ключ — CRC32 вмісту (той самий, що zlib.crc32 у відправника), тож у "db" замість
+// масиву байтів можна передати хеш уже відомої бітмапи.
+// ============================================================================
+class BitmapStore {
+ public:
+  using Ref = std::shared_ptr<const AppArena>;
+
+  explicit BitmapStore(ArenaBacking *backing) : backing_(backing) {}
+  BitmapStore(const BitmapStore &) = delete;
+  BitmapStore &operator=(const BitmapStore &) = delete;
+
+  // Сховище нових блоків; уже наявні звільняються туди, звідки взяті
+  void set_backing(ArenaBacking *backing) { this->backing_ = backing; }
+
+  // Посилання на бітмапу з таким вмістом: наявну або щойно скопійовану; nullptr — немає пам'яті.
+  // hash (якщо не nullptr) отримує CRC32 вмісту
+  Ref intern(const uint8_t *data, size_t size, uint32_t *hash = nullptr);
+  // Бітмапа за хешем, якщо її ще хтось тримає; інакше nullptr
+  Ref find(uint32_t hash) const;
+
+  size_t count() const { return this->blocks_.size(); }
+  size_t bytes() const { return this->bytes_; }
+  // Скільки разів вміст знайшовся вже збереженим (копію не створено)
+  uint32_t get_dedup_hits() const { return this->dedup_hits_; }
+  uint32_t get_dedup_bytes() const { return this->dedup_bytes_; }
+  // Зростає при кожній появі або зникненні бітмапи
+  uint32_t get_generation() const { return this->generation_; }
+  // {"count":N,"bytes":B,"hits":H,"saved":S,"hashes":["1a2b3c4d",...]}
+  void get_json(std::string &out) const;
+
+ protected:
+  // shared — блок записаний у таблицю під hash (копії при колізії — ні)
+  void release_(uint32_t hash, bool shared, AppArena *block);
+
+  ArenaBacking *backing_{nullptr};
+  std::unordered_map<uint32_t, std::weak_ptr<const AppArena>> blocks_;
+  size_t bytes_{0};
+  uint32_t dedup_hits_{0};
+  uint32_t dedup_bytes_{0};
+  uint32_t generation_{0};
+};
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,39 @@
+// color_stage.cpp
+#include "color_stage.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace esphome {
+namespace display_tools {
+
+// Канал з `bits` бітами: гамма, підлога видимості, квантування і розгортання назад у 8 біт
+static void build_channel_lut(std::array<uint8_t, 256> &lut, int bits, float gamma, uint8_t brightness) {
+  const int levels = (1 << bits) - 1;
+  // HUB75 на низькій яскравості гасить молодші бітові площини: значення, для якого
+  // v * brightness / 255 < 1, на панелі вже чорне. Тому ненульові кольори піднімаємо до цього порогу.
+  const int floor_level = std::max(1, (255 + brightness - 1) / std::max<int>(brightness, 1));
+
+  lut[0] = 0;
+  for (int v = 1; v < 256; v++) {
+    float g = 255.0f * powf(v / 255.0f, gamma);
+    int level = std::max(static_cast<int>(g + 0.5f), floor_level);
+    int q = (level * levels + 127) / 255;
+    q = std::min(std::max(q, 1), levels);
+    // квантування не повинне опустити колір нижче порогу видимості
+    while (q < levels && (q * 255 + levels / 2) / levels < floor_level)
+      q++;
+    lut[v] = static_cast<uint8_t>((q * 255 + levels / 2) / levels);
+  }
+}
+
+void ColorStage::rebuild_() {
+  build_channel_lut(this->lut_r_, 5, this->gamma_, this->brightness_);
+  build_channel_lut(this->lut_g_, 6, this->gamma_, this->brightness_);
+  build_channel_lut(this->lut_b_, 5, this->gamma_, this->brightness_);
+  for (int v = 0; v < 256; v++)
+    this->lut_night_[v] = this->lut_r_[v * this->night_level_ / 255];
+}
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,66 @@
+// color_stage.h
+#pragma once
+
+#include "esphome.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// ColorStage: кольоровий етап перед панеллю. На кожен канал — 256-елементна LUT:
+// гамма -> мінімальний видимий рівень для поточної яскравості -> квантування RGB565.
+// У гарячому шляху лише три звертання до таблиць на піксель.
+// ============================================================================
+class ColorStage {
+ public:
+  ColorStage() { this->rebuild_(); }
+
+  void set_gamma(float gamma) {
+    if (gamma == this->gamma_)
+      return;
+    this->gamma_ = gamma;
+    this->rebuild_();
+  }
+  void set_brightness(uint8_t brightness) {
+    if (brightness == this->brightness_)
+      return;
+    this->brightness_ = brightness;
+    this->rebuild_();
+  }
+  // Нічна палітра: червоний монохром за найяскравішим каналом, приглушений до level/255
+  void set_night(bool night) { this->night_ = night; }
+  void set_night_level(uint8_t level) {
+    if (level == this->night_level_)
+      return;
+    this->night_level_ = level;
+    this->rebuild_();
+  }
+  bool is_night() const { return this->night_; }
+  float get_gamma() const { return this->gamma_; }
+  uint8_t get_brightness() const { return this->brightness_; }
+
+  inline Color apply(const Color &c) const {
+    if (this->night_)
+      return Color(this->lut_night_[std::max(c.r, std::max(c.g, c.b))], 0, 0);
+    return Color(this->lut_r_[c.r], this->lut_g_[c.g], this->lut_b_[c.b]);
+  }
+
+ protected:
+  void rebuild_();
+
+  float gamma_{2.2f};
+  uint8_t brightness_{255};
+  bool night_{false};
+  uint8_t night_level_{160};
+  std::array<uint8_t, 256> lut_r_{};
+  std::array<uint8_t, 256> lut_g_{};
+  std::array<uint8_t, 256> lut_b_{};
+  std::array<uint8_t, 256> lut_night_{};
+};
+
+}  // namespace display_tools
+}  // namespace esphome
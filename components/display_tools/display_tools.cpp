@@ -54,13 +54,64 @@ std::string strip_emojis(const std::string &input) {
 
 // ---------- Життєвий цикл ESPHome ----------
 void DisplayTools::setup() {
+  if (this->persist_apps_ && this->snapshot_store_ == nullptr) {
+#ifdef USE_HOST
+    this->own_snapshot_store_.reset(new FileSnapshotStore("display_tools_apps.bin"));
+#else
+    this->own_snapshot_store_.reset(
+        new PreferencesSnapshotStore<DISPLAY_TOOLS_SNAPSHOT_SIZE>(fnv1_hash("display_tools_apps")));
+#endif
+    this->snapshot_store_ = this->own_snapshot_store_.get();
+  }
+  if (this->persist_apps_)
+    this->restore_apps_snapshot();
+
+  if (this->boot_frame_enabled_ && this->boot_frame_store_ == nullptr) {
+#ifdef USE_HOST
+    this->own_boot_frame_store_.reset(new FileSnapshotStore("display_tools_frame.bin"));
+#else
+    this->own_boot_frame_store_.reset(
+        new PreferencesSnapshotStore<DISPLAY_TOOLS_BOOT_FRAME_SIZE>(fnv1_hash("display_tools_frame")));
+#endif
+    this->boot_frame_store_ = this->own_boot_frame_store_.get();
+  }
+  if (this->boot_frame_enabled_ && this->boot_frame_store_->load(this->boot_frame_)) {
+    this->last_boot_frame_crc_ = snapshot_crc32(this->boot_frame_.data(), this->boot_frame_.size());
+    ESP_LOGI(TAG, "Loaded boot frame (%u bytes)", (unsigned) this->boot_frame_.size());
+  }
+
+  if (getAppByName_("__date__") == nullptr)
+    addApp("__date__");
   ESP_LOGI(TAG, "DisplayTools setup complete");
-  addApp("__date__");
+}
+
+void DisplayTools::loop() {
+  // Коалесування записів: пишемо, коли оновлення вщухли і минув мінімальний інтервал
+  if (this->snapshot_dirty_) {
+    const uint32_t now = millis();
+    if (now - this->snapshot_dirty_since_ >= SNAPSHOT_QUIET_MS &&
+        now - this->last_snapshot_write_ >= this->snapshot_interval_ms_) {
+      this->save_apps_snapshot();
+    }
+  }
 }
 
 void DisplayTools::dump_config() {
   ESP_LOGCONFIG(TAG, "DisplayTools: apps=%u, alerts in queue=%u", (unsigned) apps_.size(),
                 (unsigned) alert_messages_queue_.size());
+  ESP_LOGCONFIG(TAG, "  Persist apps: %s (interval %u ms)", this->persist_apps_ ? "YES" : "NO",
+                (unsigned) this->snapshot_interval_ms_);
+  ESP_LOGCONFIG(TAG, "  Gamma: %.2f, brightness: %u", this->color_stage_.get_gamma(),
+                this->color_stage_.get_brightness());
+  if (this->night_update_interval_ms_ != 0)
+    ESP_LOGCONFIG(TAG, "  Night update interval: %u ms", (unsigned) this->night_update_interval_ms_);
+  ESP_LOGCONFIG(TAG, "  Boot frame: %s (interval %u ms)", this->boot_frame_enabled_ ? "YES" : "NO",
+                (unsigned) this->boot_frame_interval_ms_);
+  ESP_LOGCONFIG(TAG, "  Memory: %u bytes used, budget %u", (unsigned) this->get_memory_used(),
+                (unsigned) this->memory_budget_);
+  ESP_LOGCONFIG(TAG, "  Bitmaps: %u stored (%u bytes), %u bytes deduplicated",
+                (unsigned) this->bitmap_store_.count(), (unsigned) this->bitmap_store_.bytes(),
+                (unsigned) this->bitmap_store_.get_dedup_bytes());
 }
 
 // ======================================================================
@@ -145,54 +196,55 @@ Color DisplayTools::hex_to_color(const std::string &hex) {
   return Color::WHITE;
 }
 
-Color DisplayTools::hsv_to_rgb(float h, float s, float v) {
-  h = fmodf(h, 360.0f);
-  s = std::min(1.0f, std::max(0.0f, s));
-  v = std::min(1.0f, std::max(0.0f, v));
-  float c = v * s;
-  float x = c * (1 - fabsf(fmodf(h / 60.0f, 2) - 1));
-  float m = v - c;
-  float rf = 0, gf = 0, bf = 0;
-  if (0 <= h && h < 60) {
-    rf = c;
-    gf = x;
-    bf = 0;
-  } else if (60 <= h && h < 120) {
-    rf = x;
-    gf = c;
-    bf = 0;
-  } else if (120 <= h && h < 180) {
-    rf = 0;
-    gf = c;
-    bf = x;
-  } else if (180 <= h && h < 240) {
-    rf = 0;
-    gf = x;
-    bf = c;
-  } else if (240 <= h && h < 300) {
-    rf = x;
-    gf = 0;
-    bf = c;
-  } else {
-    rf = c;
-    gf = 0;
-    bf = x;
+Color DisplayTools::get_temp_color(float temp) {
+  // Межі цілі (<= -10, <= 0, ...), тож відро визначає ceil(temp); таблиця на [-11..31]
+  static const int LUT_MIN = -11, LUT_MAX = 31;
+  static Color lut[LUT_MAX - LUT_MIN + 1];
+  static bool built = false;
+  if (!built) {
+    for (int t = LUT_MIN; t <= LUT_MAX; t++) {
+      Color c;
+      if (t <= -10)
+        c = Color(0, 0, 255);
+      else if (t <= 0)
+        c = Color(0, 128, 255);
+      else if (t <= 10)
+        c = Color(0, 200, 200);
+      else if (t <= 20)
+        c = Color(0, 255, 0);
+      else if (t <= 30)
+        c = Color(255, 200, 0);
+      else
+        c = Color(255, 0, 0);
+      lut[t - LUT_MIN] = c;
+    }
+    built = true;
   }
-  return Color((rf + m) * 255, (gf + m) * 255, (bf + m) * 255);
+  if (std::isnan(temp))
+    return lut[LUT_MAX - LUT_MIN];
+  const int idx = static_cast<int>(std::ceil(std::min(std::max(temp, float(LUT_MIN)), float(LUT_MAX))));
+  return lut[idx - LUT_MIN];
 }
 
-Color DisplayTools::get_temp_color(float temp) {
-  if (temp <= -10)
-    return Color(0, 0, 255);
-  if (temp <= 0)
-    return Color(0, 128, 255);
-  if (temp <= 10)
-    return Color(0, 200, 200);
-  if (temp <= 20)
-    return Color(0, 255, 0);
-  if (temp <= 30)
-    return Color(255, 200, 0);
-  return Color(255, 0, 0);
+// Неперервна шкала з тими ж опорними кольорами, що й get_temp_color
+Color DisplayTools::get_temp_ramp_color(float temp) {
+  struct Stop {
+    float t;
+    uint8_t r, g, b;
+  };
+  static const Stop STOPS[] = {{-10, 0, 0, 255},  {0, 0, 128, 255}, {10, 0, 200, 200},
+                               {20, 0, 255, 0},   {30, 255, 200, 0}, {40, 255, 0, 0}};
+  const size_t n = sizeof(STOPS) / sizeof(STOPS[0]);
+  if (temp <= STOPS[0].t)
+    return Color(STOPS[0].r, STOPS[0].g, STOPS[0].b);
+  for (size_t i = 1; i < n; i++) {
+    if (temp <= STOPS[i].t) {
+      const Stop &a = STOPS[i - 1], &b = STOPS[i];
+      const float k = (temp - a.t) / (b.t - a.t);
+      return Color(a.r + (b.r - a.r) * k, a.g + (b.g - a.g) * k, a.b + (b.b - a.b) * k);
+    }
+  }
+  return Color(STOPS[n - 1].r, STOPS[n - 1].g, STOPS[n - 1].b);
 }
 
 std::string DisplayTools::to_upper(const std::string &input) {
@@ -319,41 +371,47 @@ void DisplayTools::addApp(std::string name, std::string body, std::string color,
   }
 
   if (found != nullptr) {
-    found->body = body;
     found->color = hex_to_color(color);
     found->duration = (duration == 0) ? 2 : duration;
-    found->icon = get_icon_char(icon);
     found->icon_color = hex_to_color(icon_color);
-    found->text_parts = std::move(text_parts);
-    found->draw_objects = std::move(draw_objects);
-    ESP_LOGI(TAG, "Updated app: %s", name.c_str());
+    this->set_payload_(*found, body, get_icon_char(icon), std::move(text_parts), std::move(draw_objects));
+    this->adopt_payload_(*found);
+    found->bytes = app_bytes_(*found);
+    ESP_LOGI(TAG, "Updated app: %s (%u bytes)", name.c_str(), (unsigned) found->bytes);
     dump_app_info(*found);
+    on_apps_changed_();
+    this->enforce_memory_budget_();
     return;
   }
 
   App_Info app;
   app.name = name;
-  app.body = body;
   app.color = hex_to_color(color);
   app.duration = (duration == 0) ? 2 : duration;
-  app.icon = get_icon_char(icon);
   app.icon_color = hex_to_color(icon_color);
-  app.text_parts = std::move(text_parts);
-  app.draw_objects = std::move(draw_objects);
+  this->set_payload_(app, body, get_icon_char(icon), std::move(text_parts), std::move(draw_objects));
   app.index = apps_.empty() ? 0 : (apps_.back().index + 1);
+  this->adopt_payload_(app);
+  app.bytes = app_bytes_(app);
+  // щойно доданий app вважається показаним зараз — інакше його витіснили б першим
+  app.last_shown = this->anim_clock_.now();
 
-  ESP_LOGI(TAG, "Added app: %s", name.c_str());
+  ESP_LOGI(TAG, "Added app: %s (%u bytes)", name.c_str(), (unsigned) app.bytes);
   dump_app_info(app);
 
   apps_.push_back(std::move(app));
   if (current_app_index_ == npos)
     current_app_index_ = 0;
+  on_apps_changed_();
+  this->enforce_memory_budget_();
 }
 
 bool DisplayTools::delApp(const std::string &name) {
   for (auto it = apps_.begin(); it != apps_.end(); ++it) {
     if (it->name == name) {
       size_t deleted = std::distance(apps_.begin(), it);
+      if (deleted == current_app_index_)
+        this->anim_started_ = false;
       apps_.erase(it);
       if (apps_.empty()) {
         current_app_index_ = npos;
@@ -363,6 +421,7 @@ bool DisplayTools::delApp(const std::string &name) {
         current_app_index_--;
       }
       ESP_LOGI(TAG, "Deleted app: %s", name.c_str());
+      on_apps_changed_();
       return true;
     }
   }
@@ -374,10 +433,291 @@ void DisplayTools::nextApp() {
     current_app_index_ = npos;
     return;
   }
+  const size_t prev = current_app_index_;
   if (current_app_index_ == npos)
     current_app_index_ = 0;
   else
     current_app_index_ = (current_app_index_ + 1) % apps_.size();
+  apps_[current_app_index_].last_shown = this->anim_clock_.now();
+  // Новий app на екрані — анімації з першого кадру; той самий app (єдиний у ротації) грає далі
+  if (current_app_index_ != prev)
+    this->anim_started_ = false;
+}
+
+// Елемент за id, а якщо такого id немає — за індексом (ref із самих цифр)
+template<typename T> static T *find_patch_item(PayloadVector<T> &items, const std::string &ref) {
+  for (auto &item : items)
+    if (!item.id.empty() && std::string_view(item.id) == ref)
+      return &item;
+  if (ref.empty() || ref.size() > 5 || !std::all_of(ref.begin(), ref.end(), ::isdigit))
+    return nullptr;
+  const size_t index = strtoul(ref.c_str(), nullptr, 10);
+  return index < items.size() ? &items[index] : nullptr;
+}
+
+bool DisplayTools::patch_text_part(const std::string &name, const std::string &ref, const std::string &text) {
+  App_Info *app = this->getAppByName_(name);
+  ColoredWord *part = app != nullptr ? find_patch_item(app->text_parts, ref) : nullptr;
+  if (part == nullptr) {
+    ESP_LOGW(TAG, "Patch: no text part '%s' in app %s", ref.c_str(), name.c_str());
+    return false;
+  }
+  // Як у make_colored_words: "mdi:" — іконка своїм шрифтом
+  const bool is_icon = text.rfind("mdi:", 0) == 0;
+  const std::string_view value = is_icon ? std::string_view(get_icon_char(text)) : std::string_view(text);
+  if (value == part->text)
+    return true;
+  part->text = value;
+  if (is_icon)
+    part->font = this->icon_font_;
+  else if (part->font == this->icon_font_)
+    part->font = this->app_font_;
+  part->width = -1;  // перевимірюється лише ця частина
+  this->on_app_patched_(*app);
+  return true;
+}
+
+bool DisplayTools::patch_text_part_color(const std::string &name, const std::string &ref, Color color) {
+  App_Info *app = this->getAppByName_(name);
+  ColoredWord *part = app != nullptr ? find_patch_item(app->text_parts, ref) : nullptr;
+  if (part == nullptr) {
+    ESP_LOGW(TAG, "Patch: no text part '%s' in app %s", ref.c_str(), name.c_str());
+    return false;
+  }
+  part->color = color;
+  this->on_app_patched_(*app);
+  return true;
+}
+
+bool DisplayTools::patch_draw_object_color(const std::string &name, const std::string &ref, Color color) {
+  App_Info *app = this->getAppByName_(name);
+  DrawObject *obj = app != nullptr ? find_patch_item(app->draw_objects, ref) : nullptr;
+  if (obj == nullptr) {
+    ESP_LOGW(TAG, "Patch: no draw object '%s' in app %s", ref.c_str(), name.c_str());
+    return false;
+  }
+  obj->color = color;
+  this->on_app_patched_(*app);
+  return true;
+}
+
+bool DisplayTools::patch_draw_object_text(const std::string &name, const std::string &ref, const std::string &text) {
+  App_Info *app = this->getAppByName_(name);
+  DrawObject *obj = app != nullptr ? find_patch_item(app->draw_objects, ref) : nullptr;
+  if (obj == nullptr || obj->type != DrawCommandType::TEXT) {
+    ESP_LOGW(TAG, "Patch: no text object '%s' in app %s", ref.c_str(), name.c_str());
+    return false;
+  }
+  obj->text = text;
+  this->on_app_patched_(*app);
+  return true;
+}
+
+bool DisplayTools::patch_draw_object_coords(const std::string &name, const std::string &ref, const int *coords,
+                                            size_t count) {
+  App_Info *app = this->getAppByName_(name);
+  DrawObject *obj = app != nullptr ? find_patch_item(app->draw_objects, ref) : nullptr;
+  if (obj == nullptr) {
+    ESP_LOGW(TAG, "Patch: no draw object '%s' in app %s", ref.c_str(), name.c_str());
+    return false;
+  }
+  const bool sized = obj->type == DrawCommandType::BITMAP || obj->type == DrawCommandType::ANIMATION;
+  if (count == 0 || count > 6 || (sized && count > 2)) {
+    ESP_LOGW(TAG, "Patch: %u coordinates do not fit object '%s' in app %s", (unsigned) count, ref.c_str(),
+             name.c_str());
+    return false;
+  }
+  int *fields[] = {&obj->x1, &obj->y1, &obj->x2, &obj->y2, &obj->x3, &obj->y3};
+  for (size_t i = 0; i < count; i++)
+    *fields[i] = coords[i];
+  this->on_app_patched_(*app);
+  return true;
+}
+
+bool DisplayTools::patch_bitmap_region(const std::string &name, const std::string &ref, int x, int y, int w, int h,
+                                       const uint8_t *rgb, size_t size) {
+  App_Info *app = this->getAppByName_(name);
+  DrawObject *obj = app != nullptr ? find_patch_item(app->draw_objects, ref) : nullptr;
+  if (obj == nullptr || obj->type != DrawCommandType::BITMAP || obj->bitmap_len() == 0) {
+    ESP_LOGW(TAG, "Patch: no bitmap '%s' in app %s", ref.c_str(), name.c_str());
+    return false;
+  }
+  const int bw = obj->x2, bh = obj->y2;
+  if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > bw || y + h > bh || size != static_cast<size_t>(w * h * 3) ||
+      obj->bitmap_len() != static_cast<size_t>(bw * bh * 3)) {
+    ESP_LOGW(TAG, "Patch: region %d,%d %dx%d does not fit bitmap '%s' (%dx%d) in app %s", x, y, w, h, ref.c_str(), bw,
+             bh, name.c_str());
+    return false;
+  }
+  // Бітмапа у сховищі спільна і незмінна: змінена копія стає новою бітмапою цього app
+  std::vector<uint8_t> data(obj->bitmap_ptr(), obj->bitmap_ptr() + obj->bitmap_len());
+  for (int row = 0; row < h; row++)
+    memcpy(&data[(static_cast<size_t>(y + row) * bw + x) * 3], rgb + static_cast<size_t>(row) * w * 3,
+           static_cast<size_t>(w) * 3);
+  obj->bitmap_data = std::move(data);
+  obj->bitmap = nullptr;
+  obj->bitmap_size = 0;
+  // решта бітмап app лишає свої посилання
+  this->adopt_payload_(*app);
+  this->on_app_patched_(*app);
+  return true;
+}
+
+void DisplayTools::on_app_patched_(App_Info &app) {
+  if (&app == this->getCurrentApp())
+    this->parts_scroll_.relayout = true;
+  // Подовжені patch рядки лишають в арені старі буфери; коли їх більше половини — переносимо вантаж у нову
+  const PayloadArena *arena = app.payload.arena();
+  if (arena != nullptr && arena->freed() * 2 > arena->used()) {
+    this->set_payload_(app, app.body, app.icon, {app.text_parts.begin(), app.text_parts.end()},
+                       {app.draw_objects.begin(), app.draw_objects.end()});
+  }
+  const uint32_t bytes = app_bytes_(app);
+  if (bytes != app.bytes) {
+    app.bytes = bytes;
+    this->on_apps_changed_();
+  } else if (this->persist_apps_) {
+    this->snapshot_dirty_ = true;
+    this->snapshot_dirty_since_ = millis();
+  }
+  // нова копія бітмапи могла перевищити бюджет, навіть якщо сам app не виріс
+  this->enforce_memory_budget_();
+}
+
+size_t DisplayTools::app_bytes_(const App_Info &app) {
+  // Оцінка: сама структура + арена вантажу цілком (рядки і вектори, з тим, що звільнили patch)
+  size_t n = sizeof(App_Info) + app.name.capacity() + app.scroll.last_text.capacity();
+  if (app.payload.arena() != nullptr)
+    n += app.payload.arena()->reserved();
+  for (const auto &obj : app.draw_objects) {
+    n += obj.bitmap_data.capacity();  // бітмапа, для якої у сховищі не знайшлось місця
+    if (obj.animation != nullptr)
+      n += obj.animation->bytes();
+  }
+  // самі бітмапи — у BitmapStore (спільні рахуються там один раз); тут лише посилання
+  n += app.bitmaps.capacity() * sizeof(BitmapStore::Ref);
+  return n;
+}
+
+void DisplayTools::set_payload_(App_Info &app, std::string_view body, std::string_view icon,
+                                std::vector<ColoredWord> text_parts, std::vector<DrawObject> draw_objects) {
+  // Розмір вантажу відомий наперед, тож увесь app — один блок арени: спершу обидва вектори
+  // (з вирівнюванням), далі рядки впритул
+  size_t size = PayloadArena::footprint(text_parts.size() * sizeof(ColoredWord)) +
+                PayloadArena::footprint(draw_objects.size() * sizeof(DrawObject)) +
+                payload_string_footprint(body.size()) + payload_string_footprint(icon.size());
+  for (const auto &part : text_parts)
+    size += payload_string_footprint(part.text.size()) + payload_string_footprint(part.id.size());
+  for (const auto &obj : draw_objects)
+    size += payload_string_footprint(obj.text.size()) + payload_string_footprint(obj.id.size());
+  PayloadAllocator<char> alloc(PayloadArena::create(this->payload_backing_, size));
+  PayloadVector<ColoredWord> parts(alloc);
+  parts.reserve(text_parts.size());
+  PayloadVector<DrawObject> objects(alloc);
+  objects.reserve(draw_objects.size());
+
+  // Елементи переїжджають як є, а рядки в них створюються наново вже в арені
+  for (auto &part : text_parts) {
+    PayloadString text(part.text, alloc), id(part.id, alloc);
+    parts.push_back(std::move(part));
+    parts.back().text = std::move(text);
+    parts.back().id = std::move(id);
+  }
+  for (auto &obj : draw_objects) {
+    PayloadString text(obj.text, alloc), id(obj.id, alloc);
+    objects.push_back(std::move(obj));
+    objects.back().text = std::move(text);
+    objects.back().id = std::move(id);
+  }
+
+  // Контейнери забирають арену з собою; стара звільняється, щойно її відпустить останній з них
+  app.body = PayloadString(body.data(), body.size(), alloc);
+  app.icon = PayloadString(icon.data(), icon.size(), alloc);
+  app.text_parts = std::move(parts);
+  app.draw_objects = std::move(objects);
+  app.payload = std::move(alloc);
+}
+
+void DisplayTools::adopt_payload_(App_Info &app) {
+  std::vector<BitmapStore::Ref> refs;
+  for (auto &obj : app.draw_objects) {
+    if (obj.type != DrawCommandType::BITMAP && obj.type != DrawCommandType::ANIMATION)
+      continue;
+    BitmapStore::Ref ref;
+    if (!obj.bitmap_data.empty()) {
+      ref = this->bitmap_store_.intern(obj.bitmap_data.data(), obj.bitmap_data.size(), &obj.bitmap_hash);
+      if (ref == nullptr) {
+        ESP_LOGW(TAG, "No memory for %u-byte bitmap of app %s, keeping heap copy", (unsigned) obj.bitmap_data.size(),
+                 app.name.c_str());
+        continue;
+      }
+      std::vector<uint8_t>().swap(obj.bitmap_data);
+    } else if (obj.bitmap != nullptr) {
+      // Уже прийнятий об'єкт тримає своє посилання: копію після колізії хешу find() не знайде,
+      // а за хешем повернув би чужу бітмапу
+      for (const auto &held : app.bitmaps) {
+        if (held->data() == obj.bitmap) {
+          ref = held;
+          break;
+        }
+      }
+      if (ref == nullptr) {
+        ESP_LOGW(TAG, "App %s lost its bitmap %08x", app.name.c_str(), (unsigned) obj.bitmap_hash);
+        obj.bitmap = nullptr;
+        obj.bitmap_size = 0;
+        continue;
+      }
+    } else if (obj.bitmap_hash != 0) {
+      ref = this->bitmap_store_.find(obj.bitmap_hash);
+      if (ref == nullptr) {
+        this->missing_bitmaps_++;
+        ESP_LOGW(TAG, "App %s refers to unknown bitmap %08x, resend it with data", app.name.c_str(),
+                 (unsigned) obj.bitmap_hash);
+        continue;
+      }
+    } else {
+      continue;
+    }
+    obj.bitmap = ref->data();
+    obj.bitmap_size = ref->used();
+    refs.push_back(std::move(ref));
+    if (obj.animation != nullptr && obj.animation->adopt(this->bitmap_store_, obj.x2, obj.y2) &&
+        obj.animation->stream() != nullptr)
+      refs.push_back(obj.animation->stream());
+  }
+  // Старі посилання відпускаються лише тепер: нові хеші могли вказувати на ті самі бітмапи
+  app.bitmaps = std::move(refs);
+}
+
+size_t DisplayTools::alert_bytes_(const AlertMessage &alert) {
+  return sizeof(AlertMessage) + alert.text.capacity() + alert.icon.capacity() + alert.sound.capacity() +
+         alert.scroll.last_text.capacity();
+}
+
+void DisplayTools::enforce_memory_budget_() {
+  if (this->memory_budget_ == 0)
+    return;
+  while (this->get_apps_memory_used_() > this->memory_budget_) {
+    const App_Info *current = this->getCurrentApp();
+    const App_Info *victim = nullptr;
+    for (const auto &app : this->apps_) {
+      if (&app == current || app.name == "__date__")
+        continue;
+      if (victim == nullptr || static_cast<int32_t>(app.last_shown - victim->last_shown) < 0)
+        victim = &app;
+    }
+    if (victim == nullptr) {
+      ESP_LOGW(TAG, "Memory budget exceeded (%u of %u bytes), nothing left to evict",
+               (unsigned) this->get_apps_memory_used_(), (unsigned) this->memory_budget_);
+      return;
+    }
+    const std::string name = victim->name;
+    ESP_LOGW(TAG, "Memory budget exceeded (%u of %u bytes), evicting app %s (%u bytes)",
+             (unsigned) this->get_apps_memory_used_(), (unsigned) this->memory_budget_, name.c_str(),
+             (unsigned) victim->bytes);
+    this->evicted_apps_++;
+    this->delApp(name);
+  }
 }
 
 DisplayTools::App_Info *DisplayTools::getCurrentApp() {
@@ -388,21 +728,377 @@ DisplayTools::App_Info *DisplayTools::getCurrentApp() {
 
 void DisplayTools::reorderAppsByIndex() {
   std::sort(apps_.begin(), apps_.end(), [](const App_Info &a, const App_Info &b) { return a.index < b.index; });
+  on_apps_changed_();
 }
 
-std::string DisplayTools::get_app_loop() {
-  std::string result = "[";
-  bool first = true;
-  for (const auto &app : this->apps_) {
-    if (!first) {
-      result += ",";
-    } else {
+void DisplayTools::append_json_string_(std::string &out, const std::string &value) {
+  out += '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\')
+      out += '\\';
+    out += c;
+  }
+  out += '"';
+}
+
+const std::string &DisplayTools::get_app_loop() {
+  // Документ перебудовується лише після зміни реєстру
+  if (this->app_loop_cache_gen_ == this->apps_generation_ && !this->app_loop_cache_.empty())
+    return this->app_loop_cache_;
+
+  std::string &result = this->app_loop_cache_;
+  result.clear();
+  result.reserve(2 + this->apps_.size() * 32);
+  result += '[';
+  for (size_t i = 0; i < this->apps_.size(); i++) {
+    if (i != 0)
+      result += ',';
+    result += "{\"name\":";
+    append_json_string_(result, this->apps_[i].name);
+    result += ",\"bytes\":";
+    result += std::to_string(this->apps_[i].bytes);
+    size_t bitmap_bytes = 0;
+    for (const auto &ref : this->apps_[i].bitmaps)
+      bitmap_bytes += ref->used();
+    result += ",\"bitmaps\":";
+    result += std::to_string(bitmap_bytes);
+    result += '}';
+  }
+  result += ']';
+  this->app_loop_cache_gen_ = this->apps_generation_;
+  return result;
+}
+
+bool DisplayTools::app_loop_changed() {
+  if (this->app_loop_published_gen_ == this->apps_generation_)
+    return false;
+  this->app_loop_published_gen_ = this->apps_generation_;
+  return true;
+}
+
+bool DisplayTools::get_app_loop_delta(std::string &out) {
+  static const std::string NO_APP;
+  const App_Info *current = this->getCurrentApp();
+  const std::string &current_name = current != nullptr ? current->name : NO_APP;
+  const bool registry_changed = this->delta_apps_gen_ != this->apps_generation_;
+  const bool alerts_changed = this->delta_alerts_gen_ != this->alerts_generation_;
+  if (!registry_changed && !alerts_changed && current_name == this->delta_current_)
+    return false;
+
+  out.clear();
+  out += '{';
+  if (registry_changed) {
+    const auto &prev = this->delta_names_;
+    auto contains = [](const std::vector<std::string> &v, const std::string &name) {
+      return std::find(v.begin(), v.end(), name) != v.end();
+    };
+
+    out += "\"added\":[";
+    bool first = true;
+    for (const auto &app : this->apps_) {
+      if (contains(prev, app.name))
+        continue;
+      if (!first)
+        out += ',';
+      append_json_string_(out, app.name);
+      first = false;
+    }
+    out += "],\"removed\":[";
+    first = true;
+    std::vector<std::string> names;
+    names.reserve(this->apps_.size());
+    for (const auto &app : this->apps_)
+      names.push_back(app.name);
+    for (const auto &name : prev) {
+      if (contains(names, name))
+        continue;
+      if (!first)
+        out += ',';
+      append_json_string_(out, name);
       first = false;
     }
-    result += "\"" + app.name + "\"";
+    out += ']';
+
+    // Порядок шлемо тільки якщо спільні елементи переставлені
+    std::vector<const std::string *> kept_prev, kept_now;
+    for (const auto &name : prev)
+      if (contains(names, name))
+        kept_prev.push_back(&name);
+    for (const auto &name : names)
+      if (contains(prev, name))
+        kept_now.push_back(&name);
+    bool reordered = false;
+    for (size_t i = 0; i < kept_prev.size(); i++)
+      reordered |= *kept_prev[i] != *kept_now[i];
+    if (reordered) {
+      out += ",\"order\":";
+      out += this->get_app_loop();
+    }
+
+    this->delta_names_ = std::move(names);
+    this->delta_apps_gen_ = this->apps_generation_;
+    out += ',';
   }
-  result += "]";
-  return result;
+  out += "\"current\":";
+  append_json_string_(out, current_name);
+  out += ",\"alerts\":";
+  out += std::to_string(this->alert_messages_queue_.size());
+  out += '}';
+
+  this->delta_current_ = current_name;
+  this->delta_alerts_gen_ = this->alerts_generation_;
+  return true;
+}
+
+// ======================================================================
+//                 ЗНІМОК APPS (warm restart після ребуту/OTA)
+// ======================================================================
+// Формат v3 (little-endian; v1/v2 читаються — у них немає відповідно ANIMATION та id):
+//   "DTSN" | version:u8 | apps:u16 | app* | crc32:u32 (по всьому, що до нього)
+//   app  = name body:str | color:rgb | duration:u16 | icon:str | icon_color:rgb | index:u16
+//          | parts:u16 (text:str color:rgb font:u8 [v3: id:str])* | objects:u16 object*
+//   object = type:u8 | x1 y1 x2 y2 x3 y3:i16 | color:rgb | text:str | font:u8 | align:u8 | bitmap:u32+bytes
+//            [ANIMATION, з v2: frames:u16 (duration:u16)* | stream:u32+bytes] | [v3: id:str]
+//   str  = len:u16 + bytes
+// Шрифти зберігаються як роль (app/icon/clock/extra), бо вказівники між прошивками не стабільні.
+// Алерти не зберігаються: старе сповіщення після ребуту вже неактуальне.
+
+void DisplayTools::on_apps_changed_() {
+  this->apps_generation_++;
+  this->apps_bytes_ = 0;
+  for (const auto &app : this->apps_)
+    this->apps_bytes_ += app.bytes;
+  if (!this->persist_apps_)
+    return;
+  this->snapshot_dirty_ = true;
+  this->snapshot_dirty_since_ = millis();
+}
+
+uint8_t DisplayTools::font_role_(const BaseFont *font) const {
+  if (font == nullptr)
+    return 0;
+  if (font == this->app_font_)
+    return 1;
+  if (font == this->icon_font_)
+    return 2;
+  if (font == this->clock_font_)
+    return 3;
+  if (font == this->extra_font_)
+    return 4;
+  return 1;  // невідомий шрифт — відновлюємо як текстовий
+}
+
+BaseFont *DisplayTools::font_from_role_(uint8_t role) const {
+  switch (role) {
+    case 1:
+      return this->app_font_;
+    case 2:
+      return this->icon_font_;
+    case 3:
+      return this->clock_font_;
+    case 4:
+      return this->extra_font_;
+    default:
+      return nullptr;
+  }
+}
+
+std::vector<uint8_t> DisplayTools::encode_apps_snapshot() const {
+  std::vector<uint8_t> out;
+  out.reserve(256);
+  ByteWriter w(out);
+  w.u8('D');
+  w.u8('T');
+  w.u8('S');
+  w.u8('N');
+  w.u8(SNAPSHOT_VERSION);
+  w.u16(this->apps_.size());
+
+  for (const auto &app : this->apps_) {
+    w.str(app.name);
+    w.str(app.body);
+    w.color(app.color);
+    w.u16(app.duration);
+    w.str(app.icon);
+    w.color(app.icon_color);
+    w.u16(app.index);
+
+    w.u16(app.text_parts.size());
+    for (const auto &part : app.text_parts) {
+      w.str(part.text);
+      w.color(part.color);
+      w.u8(font_role_(part.font));
+      w.str(part.id);
+    }
+
+    w.u16(app.draw_objects.size());
+    for (const auto &obj : app.draw_objects) {
+      w.u8(static_cast<uint8_t>(obj.type));
+      w.i16(obj.x1);
+      w.i16(obj.y1);
+      w.i16(obj.x2);
+      w.i16(obj.y2);
+      w.i16(obj.x3);
+      w.i16(obj.y3);
+      w.color(obj.color);
+      w.str(obj.text);
+      w.u8(font_role_(obj.font));
+      w.u8(static_cast<uint8_t>(obj.align));
+      w.bytes(obj.bitmap_ptr(), obj.bitmap_len());
+      if (obj.type == DrawCommandType::ANIMATION) {
+        const size_t frames = obj.animation != nullptr ? obj.animation->frame_count() : 0;
+        w.u16(frames);
+        for (size_t f = 0; f < frames; f++)
+          w.u16(obj.animation->frame_duration(f));
+        if (obj.animation != nullptr)
+          w.bytes(obj.animation->stream_data(), obj.animation->stream_size());
+        else
+          w.u32(0);
+      }
+      w.str(obj.id);
+    }
+  }
+
+  w.u32(snapshot_crc32(out.data(), out.size()));
+  return out;
+}
+
+bool DisplayTools::decode_apps_snapshot(const uint8_t *data, size_t len, std::vector<App_Info> &out) const {
+  if (len < 4 + 1 + 2 + 4)
+    return false;
+  const size_t body_len = len - 4;
+  const uint32_t stored_crc = data[body_len] | (data[body_len + 1] << 8) | (data[body_len + 2] << 16) |
+                              (static_cast<uint32_t>(data[body_len + 3]) << 24);
+  if (snapshot_crc32(data, body_len) != stored_crc) {
+    ESP_LOGW(TAG, "Apps snapshot CRC mismatch");
+    return false;
+  }
+
+  ByteReader r(data, body_len);
+  if (r.u8() != 'D' || r.u8() != 'T' || r.u8() != 'S' || r.u8() != 'N')
+    return false;
+  const uint8_t version = r.u8();
+  if (version == 0 || version > SNAPSHOT_VERSION) {
+    ESP_LOGW(TAG, "Unsupported apps snapshot version %u", version);
+    return false;
+  }
+
+  std::vector<App_Info> apps;
+  const uint16_t count = r.u16();
+  apps.reserve(count);
+  for (uint16_t i = 0; i < count && r.ok(); i++) {
+    App_Info app;
+    app.name = r.str();
+    app.body = r.str();
+    app.color = r.color();
+    app.duration = r.u16();
+    app.icon = r.str();
+    app.icon_color = r.color();
+    app.index = r.u16();
+
+    const uint16_t parts = r.u16();
+    for (uint16_t p = 0; p < parts && r.ok(); p++) {
+      ColoredWord part;
+      part.text = r.str();
+      part.color = r.color();
+      part.font = font_from_role_(r.u8());
+      if (version >= 3)
+        part.id = r.str();
+      app.text_parts.push_back(std::move(part));
+    }
+
+    const uint16_t objects = r.u16();
+    for (uint16_t o = 0; o < objects && r.ok(); o++) {
+      DrawObject obj;
+      const uint8_t type = r.u8();
+      if (type > static_cast<uint8_t>(DrawCommandType::ANIMATION))
+        return false;
+      obj.type = static_cast<DrawCommandType>(type);
+      obj.x1 = r.i16();
+      obj.y1 = r.i16();
+      obj.x2 = r.i16();
+      obj.y2 = r.i16();
+      obj.x3 = r.i16();
+      obj.y3 = r.i16();
+      obj.color = r.color();
+      obj.text = r.str();
+      obj.font = font_from_role_(r.u8());
+      obj.align = static_cast<TextAlign>(r.u8());
+      obj.bitmap_data = r.bytes();
+      if (obj.type == DrawCommandType::ANIMATION) {
+        std::vector<uint16_t> durations(r.u16());
+        for (auto &d : durations)
+          d = r.u16();
+        obj.animation = std::make_shared<BitmapAnimation>();
+        obj.animation->load(std::move(durations), r.bytes());
+      }
+      if (version >= 3)
+        obj.id = r.str();
+      app.draw_objects.push_back(std::move(obj));
+    }
+    apps.push_back(std::move(app));
+  }
+
+  if (!r.ok() || r.remaining() != 0)
+    return false;
+  out = std::move(apps);
+  return true;
+}
+
+bool DisplayTools::save_apps_snapshot() {
+  if (this->snapshot_store_ == nullptr)
+    return false;
+  this->snapshot_dirty_ = false;
+  this->last_snapshot_write_ = millis();
+
+  std::vector<uint8_t> blob = this->encode_apps_snapshot();
+  const uint32_t crc = snapshot_crc32(blob.data(), blob.size());
+  if (crc == this->last_snapshot_crc_)
+    return true;  // нічого не змінилось — флеш не чіпаємо
+
+  if (!this->snapshot_store_->save(blob.data(), blob.size())) {
+    ESP_LOGW(TAG, "Failed to save apps snapshot (%u bytes)", (unsigned) blob.size());
+    return false;
+  }
+  this->last_snapshot_crc_ = crc;
+  ESP_LOGD(TAG, "Saved apps snapshot: %u apps, %u bytes", (unsigned) this->apps_.size(), (unsigned) blob.size());
+  return true;
+}
+
+bool DisplayTools::restore_apps_snapshot() {
+  if (this->snapshot_store_ == nullptr)
+    return false;
+  std::vector<uint8_t> blob;
+  if (!this->snapshot_store_->load(blob) || blob.empty())
+    return false;
+
+  std::vector<App_Info> apps;
+  if (!this->decode_apps_snapshot(blob.data(), blob.size(), apps)) {
+    ESP_LOGW(TAG, "Apps snapshot is invalid, ignoring");
+    return false;
+  }
+
+  this->apps_ = std::move(apps);
+  this->current_app_index_ = this->apps_.empty() ? npos : 0;
+  this->apps_generation_++;
+  this->apps_bytes_ = 0;
+  const uint32_t now = this->anim_clock_.now();
+  for (auto &app : this->apps_) {
+    // декодований вантаж лежить у купі — переносимо його в арену, як у addApp
+    this->set_payload_(app, app.body, app.icon,
+                       {std::make_move_iterator(app.text_parts.begin()), std::make_move_iterator(app.text_parts.end())},
+                       {std::make_move_iterator(app.draw_objects.begin()),
+                        std::make_move_iterator(app.draw_objects.end())});
+    this->adopt_payload_(app);
+    app.bytes = app_bytes_(app);
+    app.last_shown = now;
+    this->apps_bytes_ += app.bytes;
+  }
+  this->last_snapshot_crc_ = snapshot_crc32(blob.data(), blob.size());
+  ESP_LOGI(TAG, "Restored %u apps from snapshot (%u bytes)", (unsigned) this->apps_.size(), (unsigned) blob.size());
+  // Знімок міг бути записаний з більшим бюджетом (або без нього)
+  this->enforce_memory_budget_();
+  return true;
 }
 
 // ======================================================================
@@ -437,9 +1133,22 @@ void DisplayTools::addAlert(std::string text, std::string color, std::string ico
   alert.icon_color = hex_to_color(icon_color);
   alert.sound = sound;
   alert.repeat = repeat;
+  alert.bytes = alert_bytes_(alert);
 
-  alert_messages_queue_.push(alert);
+  this->alerts_bytes_ += alert.bytes;
+  alert_messages_queue_.push_back(std::move(alert));
+  alerts_generation_++;
   ESP_LOGI(TAG, "Added alert to queue: %s", text.c_str());
+
+  // Алерти не витісняють apps: у черги своя межа. Перший алерт уже на екрані, тож
+  // відкидається найстаріший з тих, що ще чекають
+  while (alert_messages_queue_.size() > MAX_QUEUED_ALERTS) {
+    auto oldest = std::next(alert_messages_queue_.begin());
+    ESP_LOGW(TAG, "Alert queue full (%u), dropping: %s", (unsigned) MAX_QUEUED_ALERTS, oldest->text.c_str());
+    this->alerts_bytes_ -= oldest->bytes;
+    alert_messages_queue_.erase(oldest);
+    this->dropped_alerts_++;
+  }
 }
 
 bool DisplayTools::hasAlert() const { return !alert_messages_queue_.empty(); }
@@ -452,28 +1161,56 @@ bool DisplayTools::getCurrentAlert(AlertMessage &out) {
 }
 
 void DisplayTools::removeCurrentAlert() {
-  if (!alert_messages_queue_.empty())
-    alert_messages_queue_.pop();
+  if (!alert_messages_queue_.empty()) {
+    this->alerts_bytes_ -= alert_messages_queue_.front().bytes;
+    alert_messages_queue_.pop_front();
+    alerts_generation_++;
+  }
   first_alert_play_ = true;
+  // пізнє підтвердження звуку вже не стосується наступного алерту
+  this->alert_sync_ = AlertSync{};
+  this->alert_hold_ = false;
+}
+
+void DisplayTools::notify_sound_started(bool ok) {
+  AlertSync &sync = this->alert_sync_;
+  if (!sync.awaiting_sound)
+    return;
+  sync.awaiting_sound = false;
+  if (!ok) {
+    ESP_LOGW(TAG, "Alert sound was not played");
+    return;
+  }
+  sync.audio_started = true;
+  sync.audio_ms = this->anim_clock_.now();
+  this->log_alert_sync_();
+}
+
+void DisplayTools::log_alert_sync_() {
+  const AlertSync &sync = this->alert_sync_;
+  if (!sync.visual_started || !sync.audio_started)
+    return;
+  // > 0: звук відстає від тексту; < 0: звук почався раніше (текст чекав кадру)
+  const int32_t offset = static_cast<int32_t>(sync.audio_ms - sync.visual_ms);
+  ESP_LOGI(TAG, "Alert A/V offset: %+d ms (sound confirmed %u ms after request, text held %u ms)", (int) offset,
+           (unsigned) (sync.audio_ms - sync.requested_ms), (unsigned) (sync.visual_ms - sync.requested_ms));
 }
 
 // ======================================================================
 //                          МАЛЮВАЛКИ (як у тебе)
 // ======================================================================
 bool DisplayTools::drawTodayDate(Display &it, BaseFont *font, int xpos, int ypos) {
-  // як в оригіналі
-  int repeat = 2;
-  static int frame_hold = 0;
-  const int hold_frames = 250 * repeat;  // ~2 сек при ~8ms кадрі
-
-  // час/дата
-  time_t now = ::time(nullptr);
-  struct tm *local_time = ::localtime(&now);
-  int day_of_month = local_time ? local_time->tm_mday : 1;
+  // як в оригіналі: ~2 с на повтор
+  const int repeat = 2;
+  const uint32_t hold_ms = HOLD_MS_PER_REPEAT * repeat;
+  const uint32_t now = this->anim_clock_.frame_time();
+  if (!this->date_hold_active_) {
+    this->date_hold_active_ = true;
+    this->date_hold_start_ = now;
+  }
 
-  // tm_wday: 0=нд, 1=пн, ..., 6=сб → робимо пн=0, нд=6
-  int day_of_week = local_time ? local_time->tm_wday : 0;
-  int adjusted_day_of_week = (day_of_week == 0) ? 6 : day_of_week - 1;
+  // час/дата — з кешу (рахується раз на добу)
+  const TimeCache &tc = this->time_cache_;
 
   // фон для дати (24x24)
   it.filled_rectangle(xpos, ypos - 16, 8 * 3, 8 * 3, Color(240, 240, 240));
@@ -482,7 +1219,7 @@ bool DisplayTools::drawTodayDate(Display &it, BaseFont *font, int xpos, int ypos
   it.filled_rectangle(xpos, ypos - 16, 8 * 3, 2 * 3, Color(240, 0, 0));
 
   // число місяця
-  it.printf(xpos + 5, ypos + 7, font, Color::BLACK, TextAlign::BASELINE_LEFT, "%02d", day_of_month);
+  it.print(xpos + 5, ypos + 7, font, Color::BLACK, TextAlign::BASELINE_LEFT, tc.day_digits);
 
   // рисочки днів тижня
   int dash_x_start = xpos + 32;
@@ -492,39 +1229,71 @@ bool DisplayTools::drawTodayDate(Display &it, BaseFont *font, int xpos, int ypos
   int dash_height = 2;
 
   for (uint8_t i = 0; i < 7; i++) {
-    Color dash_color = (i == adjusted_day_of_week) ? Color(240, 240, 240) : Color(100, 100, 100);
+    Color dash_color = (i == tc.weekday) ? Color(240, 240, 240) : Color(100, 100, 100);
     it.filled_rectangle(dash_x_start + i * (dash_width + dash_spacing), dash_y, dash_width, dash_height, dash_color);
   }
 
-  // назва місяця укр (точно як у тебе, з пробілами)
-  const std::vector<std::string> months_uk = {"",        "Січень",   "Лютий",  "Березень", "Квітень",
-                                              "Травень", "Червень",  "Липень", "Серпень",  "Вересень",
-                                              "Жовтень", "Листопад", "Грудень"};
-  std::string month = months_uk[local_time ? (local_time->tm_mon + 1) : 0];
-
+  // назва місяця (вже у верхньому регістрі); ширину міряємо раз на добу для кожного шрифту
   const int left_boundary = 32;
-
-  int text_width, text_height;
-  int dummy_y, dummy_x, dummy_h;
-  month = cyr_upper(month);
-  it.get_text_bounds(0, ypos, month.c_str(), font, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &text_width,
-                     &text_height);
+  if (tc.month_width < 0 || tc.month_width_font != font) {
+    int dummy_x, dummy_y, text_height;
+    it.get_text_bounds(0, ypos, tc.month_upper.c_str(), font, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y,
+                       &this->time_cache_.month_width, &text_height);
+    this->time_cache_.month_width_font = font;
+  }
 
   const int available_width = it.get_width() - left_boundary - 12;
 
   // it.print(xpos + 32, ypos + 4, font, Color::WHITE, TextAlign::BASELINE_LEFT, month.c_str());
-  const int center_x = left_boundary + (available_width - text_width) / 2;
-  it.print(center_x, ypos + 3, font, Color::WHITE, TextAlign::BASELINE_LEFT, month.c_str());
+  const int center_x = left_boundary + (available_width - tc.month_width) / 2;
+  it.print(center_x, ypos + 3, font, Color::WHITE, TextAlign::BASELINE_LEFT, tc.month_upper.c_str());
 
-  // затримка на кадрах
-  frame_hold++;
-  if (frame_hold >= hold_frames) {
-    frame_hold = 0;
+  // затримка в мілісекундах годинника анімацій
+  if (now - this->date_hold_start_ >= hold_ms) {
+    this->date_hold_active_ = false;
     return true;
   }
   return false;
 }
 
+void DisplayTools::update_time_cache_() {
+  TimeCache &tc = this->time_cache_;
+  const time_t now = this->anim_clock_.wall_time();
+  if (now == tc.second)
+    return;
+  tc.second = now;
+
+  // Розкладений час — раз на секунду
+  struct tm local_time {};
+  if (::localtime_r(&now, &local_time) == nullptr)
+    local_time.tm_mday = 1;
+
+  // Рядки годинника — раз на хвилину
+  const int minute_key = local_time.tm_yday * 1440 + local_time.tm_hour * 60 + local_time.tm_min;
+  if (minute_key != tc.minute_key) {
+    tc.minute_key = minute_key;
+    strftime(tc.clock_colon, sizeof(tc.clock_colon), "%H:%M", &local_time);
+    strftime(tc.clock_blank, sizeof(tc.clock_blank), "%H %M", &local_time);
+  }
+
+  // Дата і місяць — раз на добу
+  const int day_key = local_time.tm_year * 400 + local_time.tm_yday;
+  if (day_key != tc.day_key) {
+    tc.day_key = day_key;
+    snprintf(tc.day_digits, sizeof(tc.day_digits), "%02d", local_time.tm_mday);
+    // tm_wday: 0=нд, 1=пн, ..., 6=сб → робимо пн=0, нд=6
+    tc.weekday = (local_time.tm_wday == 0) ? 6 : local_time.tm_wday - 1;
+
+    // назва місяця укр (точно як у тебе)
+    static const char *const MONTHS_UK[] = {"Січень",  "Лютий",   "Березень", "Квітень",  "Травень",
+                                            "Червень", "Липень",  "Серпень",  "Вересень", "Жовтень",
+                                            "Листопад", "Грудень"};
+    const int month = local_time.tm_mon;
+    tc.month_upper = (month >= 0 && month < 12) ? cyr_upper(MONTHS_UK[month]) : std::string();
+    tc.month_width = -1;
+  }
+}
+
 // ORIGINAL
 /*
 bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::string &text, const Color &textColor,
@@ -700,89 +1469,93 @@ bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::string &tex
 }
 */
 
+void DisplayTools::print_text_(Display &it, int x, int y, BaseFont *font, Color color, TextAlign align,
+                               const char *text) {
+  if (font != nullptr && font == this->span_font_.font() && &it == &this->frame_proxy_) {
+    this->span_font_.print(this->frame_proxy_, x, y, color, align, text);
+    return;
+  }
+  it.print(x, y, font, color, align, text);
+}
+
 // FIXED SCROLL: таймерний піксельний крок (без тремтіння)
-bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::string &text, const Color &textColor,
-                                             const std::string &icon, const Color &iconColor, BaseFont *fontText,
+bool DisplayTools::drawScrollingTextWithIcon(Display &it, const char *text, const Color &textColor, const char *icon,
+                                             const Color &iconColor, BaseFont *fontText,
                                              BaseFont *fontIcon, int repeat) {
-  // ---- Статичні змінні для стану
-  static std::string last_text;
-  static bool scrolling = false;
-  static int xpos = 0;
-  static int16_t xrepeat = 0;
-  static int text_width = 0, text_height = 0;
-
-  static uint32_t hold_start_ms = 0;
-  static uint32_t last_px_step = 0;  // таймер для руху
+  // ---- Стан між кадрами
+  ScrollingState &st = this->text_scroll_;
+  const uint32_t now = this->anim_clock_.frame_time();
   const int ypos = 56;
 
   // ---- Іконка зліва
   int left_boundary = 0;
-  if (!icon.empty()) {
-    it.print(0, ypos, fontIcon, iconColor, TextAlign::BASELINE_LEFT, icon.c_str());
+  if (icon[0] != '\0') {
+    it.print(0, ypos, fontIcon, iconColor, TextAlign::BASELINE_LEFT, icon);
     int icon_w, dummy_h, dummy_x, dummy_y;
-    it.get_text_bounds(0, ypos, icon.c_str(), fontIcon, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &icon_w,
+    it.get_text_bounds(0, ypos, icon, fontIcon, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &icon_w,
                        &dummy_h);
     left_boundary = icon_w + 1;
   }
   const int available_width = it.get_width() - left_boundary;
 
   // ---- Якщо текст змінився — скинути все
-  if (text != last_text) {
-    last_text = text;
+  if (text != st.last_text) {
+    st.last_text = text;
     int dummy_x, dummy_y;
-    it.get_text_bounds(0, ypos, text.c_str(), fontText, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &text_width,
-                       &text_height);
-    scrolling = (text_width > available_width);
-    xrepeat = 0;
-    xpos = it.get_width();  // старт справа за екраном
-    hold_start_ms = millis();
-    last_px_step = millis();
+    it.get_text_bounds(0, ypos, text, fontText, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &st.text_width,
+                       &st.text_height);
+    st.scrolling = (st.text_width > available_width);
+    st.repeat = 0;
+    st.xpos = it.get_width();  // старт справа за екраном
+    st.hold_start_ms = now;
+    st.step_accum_ms = 0;
+  }
+
+  // ---- Алерт чекає на звук: час показу і крок скролу ще не йдуть
+  if (this->alert_hold_) {
+    st.hold_start_ms = now;
+    st.step_accum_ms = 0;
   }
 
   // ---- Якщо текст влазить — просто показати і потримати N мс
-  if (!scrolling) {
-    const uint32_t hold_ms = 2000u * repeat;
-    const int center_x = left_boundary + (available_width - text_width) / 2;
-    it.print(center_x, ypos, fontText, textColor, TextAlign::BASELINE_LEFT, text.c_str());
-    if ((millis() - hold_start_ms) >= hold_ms) {
-      last_text.clear();
+  if (!st.scrolling) {
+    const uint32_t hold_ms = HOLD_MS_PER_REPEAT * repeat;
+    const int center_x = left_boundary + (available_width - st.text_width) / 2;
+    this->print_text_(it, center_x, ypos, fontText, textColor, TextAlign::BASELINE_LEFT, text);
+    if ((now - st.hold_start_ms) >= hold_ms) {
+      st.last_text.clear();
       return true;
     }
     return false;
   }
 
-  const float scroll_speed = 100;  // пікселів за секунду
-  // int step = std::max(1, static_cast<int>(scroll_speed / 60.0f));
-
-  // ---- Рух: стабільний крок по таймеру
-  const uint32_t px_interval = 1000 / scroll_speed;  // мс на 1 піксель
-  if (millis() - last_px_step >= px_interval) {
-    xpos -= 1;
-    last_px_step = millis();
-  }
+  // ---- Рух: фіксований крок годинника анімацій (SCROLL_STEP_MS на піксель)
+  if (!this->alert_hold_)
+    st.xpos -= this->anim_clock_.steps(st.step_accum_ms, SCROLL_STEP_MS);
 
   // ---- Кліпінг
-  it.start_clipping(left_boundary, ypos - text_height, it.get_width(), ypos + text_height);
+  it.start_clipping(left_boundary, ypos - st.text_height, it.get_width(), ypos + st.text_height);
   auto clip = it.get_clipping();
   const int clipping_left = clip.x;
   const int clipping_right = clip.x + clip.w;
-  const int reset_threshold = clipping_left - text_width;
+  const int reset_threshold = clipping_left - st.text_width;
 
   // ---- Коли текст вийшов за межі
-  if (xpos < reset_threshold) {
-    xpos = clipping_right;
-    xrepeat++;
-    if (xrepeat >= repeat) {
-      last_text.clear();
-      xrepeat = 0;
-      scrolling = false;
+  if (st.xpos < reset_threshold) {
+    st.xpos = clipping_right;
+    st.step_accum_ms = 0;
+    st.repeat++;
+    if (st.repeat >= repeat) {
+      st.last_text.clear();
+      st.repeat = 0;
+      st.scrolling = false;
       it.end_clipping();
       return true;
     }
   }
 
   // ---- Малюємо
-  it.print(xpos, ypos, fontText, textColor, TextAlign::BASELINE_LEFT, text.c_str());
+  this->print_text_(it, st.xpos, ypos, fontText, textColor, TextAlign::BASELINE_LEFT, text);
   it.end_clipping();
   return false;
 }
@@ -790,10 +1563,11 @@ bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::string &tex
 bool DisplayTools::drawPagedTextWithIcon(Display &it, const std::string &text, const Color &textColor,
                                          const std::string &icon, const Color &iconColor, BaseFont *fontText,
                                          BaseFont *fontIcon, int repeat) {
-  static std::vector<std::string> pages;
-  static size_t current_page = 0;
-  static std::string last_text;
-  static uint32_t hold_start_ms = 0;
+  std::vector<std::string> &pages = this->paged_.pages;
+  size_t &current_page = this->paged_.current_page;
+  std::string &last_text = this->paged_.last_text;
+  uint32_t &hold_start_ms = this->paged_.hold_start_ms;
+  const uint32_t now = this->anim_clock_.frame_time();
   const int ypos = 56;
 
   // ---- Іконка
@@ -835,8 +1609,10 @@ bool DisplayTools::drawPagedTextWithIcon(Display &it, const std::string &text, c
     if (!line.empty())
       pages.push_back(line);
 
-    hold_start_ms = millis();
+    hold_start_ms = now;
   }
+  if (this->alert_hold_)
+    hold_start_ms = now;
 
   // ---- Показати поточну сторінку
   if (current_page < pages.size()) {
@@ -846,12 +1622,12 @@ bool DisplayTools::drawPagedTextWithIcon(Display &it, const std::string &text, c
                        &text_h);
 
     const int center_x = left_boundary + (available_width - text_w) / 2;
-    it.print(center_x, ypos, fontText, textColor, TextAlign::BASELINE_LEFT, page_text.c_str());
+    this->print_text_(it, center_x, ypos, fontText, textColor, TextAlign::BASELINE_LEFT, page_text.c_str());
 
-    const uint32_t hold_ms = 2000u * repeat;
-    if ((millis() - hold_start_ms) >= hold_ms) {
+    const uint32_t hold_ms = HOLD_MS_PER_REPEAT * repeat;
+    if ((now - hold_start_ms) >= hold_ms) {
       current_page++;
-      hold_start_ms = millis();
+      hold_start_ms = now;
     }
     return false;
   }
@@ -863,8 +1639,8 @@ bool DisplayTools::drawPagedTextWithIcon(Display &it, const std::string &text, c
   return true;
 }
 
-bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::vector<ColoredWord> &textParts,
-                                             const std::string &icon, const Color &iconColor, BaseFont *fontIcon,
+bool DisplayTools::drawScrollingTextWithIcon(Display &it, PayloadVector<ColoredWord> &textParts,
+                                             const char *icon, const Color &iconColor, BaseFont *fontIcon,
                                              int repeat) {
   int ypos = 56;
 
@@ -872,87 +1648,81 @@ bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::vector<Colo
   int icon_width = 0;
   int dummy_y, dummy_x, dummy_h;
 
-  if (!icon.empty()) {
-    it.print(0, ypos, fontIcon, iconColor, TextAlign::BASELINE_LEFT, icon.c_str());
-    it.get_text_bounds(0, ypos, icon.c_str(), fontIcon, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &icon_width,
+  if (icon[0] != '\0') {
+    it.print(0, ypos, fontIcon, iconColor, TextAlign::BASELINE_LEFT, icon);
+    it.get_text_bounds(0, ypos, icon, fontIcon, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &icon_width,
                        &dummy_h);
     left_boundary = icon_width + 1;
   }
 
-  // Статичні змінні для збереження стану скролінгу між викликами
-  static int16_t xpos = 0;
-  static int16_t xrepeat = 0;
-  static std::string last_text_combined;
-  static bool scrolling = false;
-  static unsigned long last_update = 0;
-  const unsigned long SCROLL_SPEED = 10;  // Чим менше значення, тим швидше скролінг
+  // Стан скролінгу між кадрами
+  ScrollingState &st = this->parts_scroll_;
+  const uint32_t now = this->anim_clock_.frame_time();
 
-  // Вимірюємо загальну ширину всіх частин тексту
+  // Загальна ширина всіх частин тексту; кожна частина міряється лише раз (і після patch)
   int total_text_width = 0;
   std::string current_text_combined;
   int max_font_height = 0;
 
-  for (const auto &part : textParts) {
+  for (auto &part : textParts) {
     if (part.text.empty() || part.font == nullptr) {
       continue;
     }
-    int part_width, part_height;
-    it.get_text_bounds(0, ypos, part.text.c_str(), part.font, esphome::display::TextAlign::BASELINE_LEFT, &dummy_x,
-                       &dummy_y, &part_width, &part_height);
-    // Додаємо відступ між частинами тексту
-    part_width += 2;
+    if (part.width < 0) {
+      int part_width, part_height;
+      it.get_text_bounds(0, ypos, part.text.c_str(), part.font, esphome::display::TextAlign::BASELINE_LEFT, &dummy_x,
+                         &dummy_y, &part_width, &part_height);
+      // Додаємо відступ між частинами тексту
+      part.width = part_width + 2;
+      part.height = part_height;
+    }
 
-    total_text_width += part_width;
+    total_text_width += part.width;
     current_text_combined += part.text;
-    if (part_height > max_font_height) {
-      max_font_height = part_height;
+    if (part.height > max_font_height) {
+      max_font_height = part.height;
     }
   }
 
   // Визначаємо доступну ширину для тексту, враховуючи іконку
   int available_width = it.get_width() - left_boundary;
 
-  // Скидаємо стан, якщо текст змінився
-  if (current_text_combined != last_text_combined) {
-    last_text_combined = current_text_combined;
-    xrepeat = 0;
-    xpos = available_width;
-    scrolling = total_text_width > available_width;
-    last_update = millis();
-    // ESP_LOGD(TAG, "Текст змінився. Новий стан: 'scrolling': %s", scrolling ? "true" : "false");
+  // Скидаємо стан, якщо текст змінився (крім patch, після якого режим показу не змінився)
+  if (current_text_combined != st.last_text) {
+    const bool scrolling = total_text_width > available_width;
+    if (st.relayout && !st.last_text.empty() && scrolling == st.scrolling) {
+      st.last_text = current_text_combined;
+    } else {
+      st.last_text = current_text_combined;
+      st.repeat = 0;
+      st.xpos = available_width;
+      st.scrolling = scrolling;
+      st.step_accum_ms = 0;
+      st.hold_start_ms = now;
+      // ESP_LOGD(TAG, "Текст змінився. Новий стан: 'scrolling': %s", scrolling ? "true" : "false");
+    }
   }
+  st.relayout = false;
 
   // Якщо текст поміщається без скролінгу
-  if (!scrolling) {
+  if (!st.scrolling) {
     int current_x = left_boundary + (available_width - total_text_width) / 2;
     for (const auto &part : textParts) {
       if (part.text.empty() || part.font == nullptr) {
         continue;
       }
-      it.print(current_x, ypos, part.font, part.color, esphome::display::TextAlign::BASELINE_LEFT, part.text.c_str());
-      int part_width;
-      it.get_text_bounds(0, ypos, part.text.c_str(), part.font, esphome::display::TextAlign::BASELINE_LEFT, &dummy_x,
-                         &dummy_y, &part_width, &dummy_h);
-      // Додаємо відступ між частинами тексту
-      part_width += 2;
-
-      current_x += part_width;
-    }
-
-    static unsigned long hold_time_start = 0;
-    const unsigned long hold_duration = 2000;
-
-    if (hold_time_start == 0) {
-      hold_time_start = millis();
+      this->print_text_(it, current_x, ypos, part.font, part.color, esphome::display::TextAlign::BASELINE_LEFT,
+                        part.text.c_str());
+      current_x += part.width;
     }
 
-    if (millis() - hold_time_start >= hold_duration) {
-      hold_time_start = 0;
-      xrepeat++;
-      if (xrepeat >= repeat) {
-        last_text_combined = "";
-        xrepeat = 0;
-        scrolling = false;
+    if (now - st.hold_start_ms >= HOLD_MS_PER_REPEAT) {
+      st.hold_start_ms = now;
+      st.repeat++;
+      if (st.repeat >= repeat) {
+        st.last_text = "";
+        st.repeat = 0;
+        st.scrolling = false;
         return true;
       }
     }
@@ -962,38 +1732,32 @@ bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::vector<Colo
   // Скролінг
   it.start_clipping(left_boundary, ypos - max_font_height, it.get_width(), ypos + max_font_height);
 
-  if (millis() - last_update >= SCROLL_SPEED) {
-    xpos--;
-    last_update = millis();
-  }
+  st.xpos -= this->anim_clock_.steps(st.step_accum_ms, SCROLL_STEP_MS);
 
-  int current_x = left_boundary + xpos;
+  int current_x = left_boundary + st.xpos;
 
   // Малюємо кожну частину тексту
   for (const auto &part : textParts) {
     if (part.text.empty() || part.font == nullptr) {
       continue;
     }
-    it.print(current_x, ypos, part.font, part.color, esphome::display::TextAlign::BASELINE_LEFT, part.text.c_str());
-    int part_width, part_height;
-    it.get_text_bounds(0, ypos, part.text.c_str(), part.font, esphome::display::TextAlign::BASELINE_LEFT, &dummy_x,
-                       &dummy_y, &part_width, &part_height);
-    // Додаємо відступ між частинами тексту
-    part_width += 2;
-    current_x += part_width;
+    this->print_text_(it, current_x, ypos, part.font, part.color, esphome::display::TextAlign::BASELINE_LEFT,
+                      part.text.c_str());
+    current_x += part.width;
   }
 
   it.end_clipping();
 
   // Перевіряємо, чи потрібно скинути скролінг
   int reset_threshold = -(total_text_width);
-  if (xpos < reset_threshold) {
-    xpos = available_width;
-    xrepeat++;
-    if (xrepeat >= repeat) {
-      last_text_combined = "";
-      xrepeat = 0;
-      scrolling = false;
+  if (st.xpos < reset_threshold) {
+    st.xpos = available_width;
+    st.step_accum_ms = 0;
+    st.repeat++;
+    if (st.repeat >= repeat) {
+      st.last_text = "";
+      st.repeat = 0;
+      st.scrolling = false;
       return true;
     }
   }
@@ -1002,22 +1766,22 @@ bool DisplayTools::drawScrollingTextWithIcon(Display &it, const std::vector<Colo
 }
 
 void DisplayTools::draw_bitmap_from_vector(esphome::display::Display &it, int x, int y, int w, int h,
-                             const std::vector<uint8_t> &bmp_data) {
+                                           const uint8_t *bmp_data, size_t size) {
   if (w <= 0 || h <= 0) {
     ESP_LOGE("DrawObjects", "Invalid bitmap dimensions.");
     return;
   }
 
   // Перевірка, чи розмір вектора відповідає очікуваному
-  if (bmp_data.size() != w * h * 3) {
-    ESP_LOGE("DrawObjects", "Bitmap data size mismatch. Expected %d, got %d.", w * h * 3, bmp_data.size());
+  if (size != static_cast<size_t>(w * h * 3)) {
+    ESP_LOGE("DrawObjects", "Bitmap data size mismatch. Expected %d, got %d.", w * h * 3, (int) size);
     return;
   }
 
   for (int i = 0; i < h; i++) {
     for (int j = 0; j < w; j++) {
-      int index = (i * w + j) * 3;
-      if (index + 2 < bmp_data.size()) {
+      const size_t index = static_cast<size_t>(i * w + j) * 3;
+      if (index + 2 < size) {
         esphome::Color color(bmp_data[index], bmp_data[index + 1], bmp_data[index + 2]);
         it.draw_pixel_at(x + j, y + i, color);
       }
@@ -1025,80 +1789,118 @@ void DisplayTools::draw_bitmap_from_vector(esphome::display::Display &it, int x,
   }
 }
 
-bool DisplayTools::drawDrawObjects(Display &it, BaseFont *textFont, const std::vector<DrawObject> &objects) {
+const uint8_t *DisplayTools::animation_frame_(const DrawObject &obj, size_t frame) {
+  const size_t size = obj.bitmap_len();
+  if (size == 0)
+    return nullptr;
+  if (frame == 0 || obj.animation == nullptr)
+    return obj.bitmap_ptr();
+
+  // Уперед від уже розгорнутого кадру тієї ж анімації; інакше — від ключового
+  const uint32_t id = obj.animation->id();
+  size_t from;
+  if (this->anim_scratch_id_ == id && this->anim_scratch_.size() == size && this->anim_scratch_frame_ <= frame) {
+    from = this->anim_scratch_frame_ + 1;
+  } else {
+    this->anim_scratch_.resize(size);
+    memcpy(this->anim_scratch_.data(), obj.bitmap_ptr(), size);
+    this->anim_scratch_id_ = id;
+    from = 1;
+  }
+  for (size_t i = from; i <= frame; i++)
+    obj.animation->apply(i, this->anim_scratch_.data());
+  this->anim_scratch_frame_ = frame;
+  return this->anim_scratch_.data();
+}
+
+bool DisplayTools::drawDrawObjects(Display &it, BaseFont *textFont, const PayloadVector<DrawObject> &objects,
+                                   int dx) {
   for (const auto &cmd : objects) {
+    // зсув праворуч (під іконку); у бітмап x2 — ширина, а не координата
+    const int x1 = cmd.x1 + dx, x3 = cmd.x3 + dx;
+    const int x2 =
+        cmd.type != DrawCommandType::BITMAP && cmd.type != DrawCommandType::ANIMATION ? cmd.x2 + dx : cmd.x2;
     switch (cmd.type) {
       case DrawCommandType::PIXEL:
-        it.draw_pixel_at(cmd.x1, cmd.y1, cmd.color);
+        it.draw_pixel_at(x1, cmd.y1, cmd.color);
         break;
       case DrawCommandType::LINE:
-        it.line(cmd.x1, cmd.y1, cmd.x2, cmd.y2, cmd.color);
+        it.line(x1, cmd.y1, x2, cmd.y2, cmd.color);
         break;
       case DrawCommandType::HLINE:
-        it.horizontal_line(cmd.x1, cmd.y1, cmd.x2, cmd.color);
+        it.horizontal_line(x1, cmd.y1, x2, cmd.color);
         break;
       case DrawCommandType::VLINE:
-        it.vertical_line(cmd.x1, cmd.y1, cmd.y2, cmd.color);
+        it.vertical_line(x1, cmd.y1, cmd.y2, cmd.color);
         break;
       case DrawCommandType::CIRCLE:
-        it.circle(cmd.x1, cmd.y1, cmd.x2, cmd.color);  // x2 = radius        
+        it.circle(x1, cmd.y1, x2, cmd.color);  // x2 = radius        
         break;
       case DrawCommandType::FILLED_CIRCLE:
-        it.filled_circle(cmd.x1, cmd.y1, cmd.x2, cmd.color);  // x2 = radius
+        it.filled_circle(x1, cmd.y1, x2, cmd.color);  // x2 = radius
         break;  
       case DrawCommandType::RECTANGLE:
-        it.rectangle(cmd.x1, cmd.y1, cmd.x2, cmd.y2, cmd.color);
+        it.rectangle(x1, cmd.y1, x2, cmd.y2, cmd.color);
         break;
       case DrawCommandType::FILLED_RECTANGLE:
-        it.filled_rectangle(cmd.x1, cmd.y1, cmd.x2, cmd.y2, cmd.color);
+        it.filled_rectangle(x1, cmd.y1, x2, cmd.y2, cmd.color);
         break;
       case DrawCommandType::TRIANGLE:
-        it.triangle(cmd.x1, cmd.y1, cmd.x2, cmd.y2, cmd.x3, cmd.y3, cmd.color);
+        it.triangle(x1, cmd.y1, x2, cmd.y2, x3, cmd.y3, cmd.color);
         break;
       case DrawCommandType::FILLED_TRIANGLE:
-        it.filled_triangle(cmd.x1, cmd.y1, cmd.x2, cmd.y2, cmd.x3, cmd.y3, cmd.color);
+        it.filled_triangle(x1, cmd.y1, x2, cmd.y2, x3, cmd.y3, cmd.color);
         break;
       case DrawCommandType::TEXT: {
         BaseFont *f = cmd.font ? cmd.font : textFont;
-        it.print(cmd.x1, cmd.y1, f, cmd.color, cmd.align, cmd.text.c_str());
+        this->print_text_(it, x1, cmd.y1, f, cmd.color, cmd.align, cmd.text.c_str());
         break;
       }
       case DrawCommandType::BITMAP:
-        this->draw_bitmap_from_vector(it, cmd.x1, cmd.y1, cmd.x2, cmd.y2, cmd.bitmap_data);
+        // посилання на невідомий хеш нічого не малює (попередження вже було в addApp)
+        if (cmd.bitmap_len() != 0)
+          this->draw_bitmap_from_vector(it, x1, cmd.y1, x2, cmd.y2, cmd.bitmap_ptr(), cmd.bitmap_len());
+        break;
+      case DrawCommandType::ANIMATION: {
+        // кадр за часом від початку показу app (годинник анімацій); цикл утримання його не скидає
+        size_t frame = 0;
+        if (cmd.animation != nullptr)
+          frame = cmd.animation->frame_at(this->anim_clock_.frame_time() - this->anim_start_ms_);
+        const uint8_t *rgb = this->animation_frame_(cmd, frame);
+        if (rgb != nullptr)
+          this->draw_bitmap_from_vector(it, x1, cmd.y1, x2, cmd.y2, rgb, cmd.bitmap_len());
         break;
+      }
     }
   }
   return true;
 }
 
-bool DisplayTools::drawDrawObjectsWithIcon(Display &it, BaseFont *textFont, const std::vector<DrawObject> &objects,
-                                           const std::string &icon, BaseFont *iconFont, const Color &iconColor) {
+bool DisplayTools::drawDrawObjectsWithIcon(Display &it, BaseFont *textFont, const PayloadVector<DrawObject> &objects,
+                                           const char *icon, BaseFont *iconFont, const Color &iconColor,
+                                           int repeat) {
   int left_boundary = 0;
   int ypos = 56;
   int icon_width = 0, dummy_y = 0, dummy_x = 0, dummy_h = 0;
-  if (!icon.empty()) {
-    it.print(0, ypos, iconFont, iconColor, TextAlign::BASELINE_LEFT, icon.c_str());
-    it.get_text_bounds(0, ypos, icon.c_str(), iconFont, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &icon_width,
+  if (icon[0] != '\0') {
+    it.print(0, ypos, iconFont, iconColor, TextAlign::BASELINE_LEFT, icon);
+    it.get_text_bounds(0, ypos, icon, iconFont, TextAlign::BASELINE_LEFT, &dummy_x, &dummy_y, &icon_width,
                        &dummy_h);
     left_boundary = icon_width + 1;
   }
-  std::vector<DrawObject> shifted = objects;
-  for (auto &o : shifted) {
-    o.x1 += left_boundary;
-    o.x2 += left_boundary;
-    o.x3 += left_boundary;
-  }
 
-  int repeat = 1;
-  static int frame_hold = 0;
-  const int hold_frames = 250 * repeat;  // ~2 сек при ~8ms кадрі
+  const uint32_t hold_ms = HOLD_MS_PER_REPEAT * std::max(repeat, 1);
+  const uint32_t now = this->anim_clock_.frame_time();
+  if (!this->draw_hold_active_) {
+    this->draw_hold_active_ = true;
+    this->draw_hold_start_ = now;
+  }
 
-  drawDrawObjects(it, textFont, shifted);
+  drawDrawObjects(it, textFont, objects, left_boundary);
 
-  // затримка на кадрах
-  frame_hold++;
-  if (frame_hold >= hold_frames) {
-    frame_hold = 0;
+  // затримка в мілісекундах годинника анімацій
+  if (now - this->draw_hold_start_ >= hold_ms) {
+    this->draw_hold_active_ = false;
     return true;
   }
   return false;
@@ -1112,38 +1914,53 @@ DisplayTools::App_Info *DisplayTools::getAppByName_(const std::string &name) {
   return nullptr;
 }
 
-void DisplayTools::draw_colored_line(esphome::display::Display &it, std::vector<int> temp_forecast,
-                                     bool night_mode_state) {
-  const int screen_width = it.get_width();
-  const int screen_height = it.get_height();
-  const int line_y = screen_height / 2;
+void DisplayTools::set_temperature_progress(const std::vector<int> &progress) {
+  this->temperature_progress_ = progress;
+  this->build_forecast_row_(FORECAST_ROW_WIDTH);
+}
 
-  // Якщо масив порожній, малюємо просту сіру лінію
-  if (night_mode_state || temp_forecast.empty()) {
-    it.line(0, line_y, screen_width, line_y, night_mode_state ? RED : LIGHT_GRAY);
+void DisplayTools::build_forecast_row_(int width) {
+  const int total_temps = this->temperature_progress_.size();
+  this->forecast_row_.clear();
+  if (total_temps == 0 || width <= 0)
     return;
-  }
-
-  // Обчислюємо розмір "кроку" для проходження по масиву
-  const int total_temps = temp_forecast.size();
 
-  // Малюємо лінію, використовуючи апроксимацію на всю довжину екрана
-  for (size_t i = 0; i < total_temps; ++i) {
-    // Обчислюємо початкову і кінцеву x-координати
-    // Використовуємо кастинг до double, щоб уникнути помилок округлення
-    int start_x = static_cast<int>(static_cast<double>(screen_width) * i / total_temps);
-    int end_x = static_cast<int>(static_cast<double>(screen_width) * (i + 1) / total_temps);
+  // Точка прогнозу i стоїть у центрі свого сегмента; між центрами — лінійна інтерполяція,
+  // на краях тримаємо крайнє значення
+  this->forecast_row_.resize(width);
+  for (int x = 0; x < width; x++) {
+    float pos = (x + 0.5f) * total_temps / width - 0.5f;
+    pos = std::min(std::max(pos, 0.0f), static_cast<float>(total_temps - 1));
+    const int i = static_cast<int>(pos);
+    const int j = std::min(i + 1, total_temps - 1);
+    const float t = pos - i;
+    const float temp = this->temperature_progress_[i] * (1.0f - t) + this->temperature_progress_[j] * t;
+    this->forecast_row_[x] = get_temp_ramp_color(temp);
+  }
+}
 
-    // Якщо це останній сегмент, переконаємося, що він досягає кінця екрана
-    if (i == total_temps - 1) {
-      end_x = screen_width;
-    }
+void DisplayTools::draw_colored_line(esphome::display::Display &it) {
+  const int screen_width = it.get_width();
+  const int line_y = it.get_height() / 2;
 
-    // Отримуємо колір для поточної температури
-    esphome::Color temp_color = get_temp_color(temp_forecast[i]);
+  // Якщо масив порожній, малюємо просту сіру лінію
+  // Уночі градієнт не потрібен — кольори однаково зведе нічна палітра
+  if (this->night_mode_state_ || this->temperature_progress_.empty()) {
+    it.horizontal_line(0, line_y, screen_width, LIGHT_GRAY);
+    return;
+  }
 
-    // Малюємо лінію для поточного сегмента
-    it.line(start_x, line_y, end_x, line_y, temp_color);
+  if (static_cast<int>(this->forecast_row_.size()) != screen_width)
+    this->build_forecast_row_(screen_width);
+
+  // Готовий рядок; однакові сусідні кольори зливаємо у відрізки
+  for (int x = 0; x < screen_width;) {
+    const Color c = this->forecast_row_[x];
+    int run = 1;
+    while (x + run < screen_width && this->forecast_row_[x + run] == c)
+      run++;
+    it.horizontal_line(x, line_y, run, c);
+    x += run;
   }
 }
 
@@ -1169,50 +1986,42 @@ void DisplayTools::draw_alert_corner(Display &it, Corner corner, const Color &co
 }
 
 void DisplayTools::render_main_screen(display::Display &it) {
-  const int blink_interval = 125;
-  this->tick_counter_++;
-  bool tick = (this->tick_counter_ / blink_interval) % 2 == 0;
+  // Кольори тут денні: нічну палітру накладає ColorStage при композиції
+  // двокрапка блимає за парністю секунди (не за лічильником кадрів); уночі не блимає
+  bool tick = this->night_mode_state_ || (this->time_cache_.second % 2) == 0;
 
   // --- Clock ---
   if (this->clock_time_ != nullptr && this->clock_font_ != nullptr) {
-    char str[17];
-    time_t currTime = this->clock_time_->now().timestamp;
-    if (tick)
-      strftime(str, sizeof(str), "%H:%M", localtime(&currTime));
-    else
-      strftime(str, sizeof(str), "%H %M", localtime(&currTime));
-
-    it.print(19, 28, this->clock_font_, this->night_mode_state_ ? RED : LIGHT_GRAY, TextAlign::BASELINE_LEFT, str);
+    const char *str = tick ? this->time_cache_.clock_colon : this->time_cache_.clock_blank;
+    it.print(19, 28, this->clock_font_, LIGHT_GRAY, TextAlign::BASELINE_LEFT, str);
   }
 
   // --- Outside temp ---
   if (!std::isnan(this->temperature_outside_)) {
     auto outside_color = get_temp_color(this->temperature_outside_);
     it.print(
-        2, 12, this->extra_font_, this->night_mode_state_ ? RED : outside_color, TextAlign::BASELINE_LEFT,
+        2, 12, this->extra_font_, outside_color, TextAlign::BASELINE_LEFT,
         ((this->temperature_outside_ > 0 ? "+" : "") + std::to_string((int) this->temperature_outside_) + "°").c_str());
   } else {
-    it.print(2, 12, this->extra_font_, this->night_mode_state_ ? RED : YELLOW, TextAlign::BASELINE_LEFT, "---°");
+    it.print(2, 12, this->extra_font_, YELLOW, TextAlign::BASELINE_LEFT, "---°");
   }
 
-  // --- Weather icon ---
-  if (!this->weather_icon_.empty()) {
-    if (!this->night_mode_state_) {
-      it.print(102, 24, this->icon_font_, ORANGE, TextAlign::BASELINE_LEFT, get_icon_char(this->weather_icon_));
-    }
+  // --- Weather icon (уночі не розкладаємо взагалі) ---
+  if (!this->night_mode_state_ && !this->weather_icon_.empty()) {
+    it.print(102, 24, this->icon_font_, ORANGE, TextAlign::BASELINE_LEFT, get_icon_char(this->weather_icon_));
   }
 
   // --- Inside temp ---
   if (!std::isnan(this->temperature_inside_)) {
     auto inside_color = get_temp_color(this->temperature_inside_);
     it.print(
-        2, 26, this->extra_font_, this->night_mode_state_ ? RED : inside_color, TextAlign::BASELINE_LEFT,
+        2, 26, this->extra_font_, inside_color, TextAlign::BASELINE_LEFT,
         ((this->temperature_inside_ > 0 ? "+" : "") + std::to_string((int) this->temperature_inside_) + "°").c_str());
   } else {
-    it.print(2, 26, this->extra_font_, this->night_mode_state_ ? RED : YELLOW, TextAlign::BASELINE_LEFT, "---°");
+    it.print(2, 26, this->extra_font_, YELLOW, TextAlign::BASELINE_LEFT, "---°");
   }
 
-  draw_colored_line(it, this->temperature_progress_, this->night_mode_state_);
+  draw_colored_line(it);
 
   for (Corner c : {Corner::TOP_LEFT, Corner::TOP_RIGHT, Corner::BOTTOM_RIGHT, Corner::BOTTOM_LEFT}) {
     if (get_corner_state(c)) {
@@ -1229,11 +2038,16 @@ void DisplayTools::render_app_screen(display::Display &it) {
   // Alerts мають пріоритет
   AlertMessage alert;
   if (this->getCurrentAlert(alert)) {
+    const uint32_t now = this->anim_clock_.frame_time();
     if (first_alert_play_) {
       char *endptr = nullptr;
       long val = strtol(alert.sound.c_str(), &endptr, 10);
 
+      this->alert_sync_ = AlertSync{};
+      this->alert_sync_.requested_ms = now;
       if (endptr != alert.sound.c_str() && *endptr == '\0') {
+        // прапорець ставимо до тригера: плеєр може відповісти (або відмовити) синхронно
+        this->alert_sync_.awaiting_sound = true;
         emit_on_play_sound(static_cast<int>(val));
       } else {
         ESP_LOGW("display_tools", "Invalid number string: '%s'", alert.sound.c_str());
@@ -1241,13 +2055,25 @@ void DisplayTools::render_app_screen(display::Display &it) {
 
       first_alert_play_ = false;
     }
+
+    // Тримаємо перший крок, доки плеєр не підтвердив звук (або не вийшов час)
+    AlertSync &sync = this->alert_sync_;
+    this->alert_hold_ = sync.awaiting_sound && this->sound_sync_timeout_ms_ > 0 &&
+                        now - sync.requested_ms < this->sound_sync_timeout_ms_;
+    if (!this->alert_hold_ && !sync.visual_started) {
+      sync.visual_started = true;
+      sync.visual_ms = now;
+      if (sync.awaiting_sound && this->sound_sync_timeout_ms_ > 0)
+        ESP_LOGW(TAG, "No sound confirmation within %u ms, starting alert", (unsigned) this->sound_sync_timeout_ms_);
+      this->log_alert_sync_();
+    }
     bool done = false;
     if (alert.text.length() > 255) {
       done = this->drawPagedTextWithIcon(it, alert.text, alert.color, alert.icon, alert.icon_color, this->app_font_,
                                          this->icon_font_, alert.repeat);
     } else {
-      done = this->drawScrollingTextWithIcon(it, alert.text, alert.color, alert.icon, alert.icon_color, this->app_font_,
-                                             this->icon_font_, alert.repeat);
+      done = this->drawScrollingTextWithIcon(it, alert.text.c_str(), alert.color, alert.icon.c_str(), alert.icon_color,
+                                             this->app_font_, this->icon_font_, alert.repeat);
     }
 
     if (done) {
@@ -1257,8 +2083,8 @@ void DisplayTools::render_app_screen(display::Display &it) {
   }
 
   if (this->night_mode_state_) {
-    // Якщо нічний режим, то не показувати сповіщення
-    it.print((it.get_width() / 2) - 10, 57, this->icon_font_, RED, TextAlign::BASELINE_LEFT,
+    // Якщо нічний режим, то не показувати сповіщення (apps навіть не розкладаємо)
+    it.print((it.get_width() / 2) - 10, 57, this->icon_font_, LIGHT_GRAY, TextAlign::BASELINE_LEFT,
              get_icon_char("mdi:bed-clock"));
     return;
   }
@@ -1269,18 +2095,22 @@ void DisplayTools::render_app_screen(display::Display &it) {
     bool done = false;
 
     if (!app->text_parts.empty()) {
-      done = this->drawScrollingTextWithIcon(it, app->text_parts, app->icon, app->icon_color, this->icon_font_,
+      done = this->drawScrollingTextWithIcon(it, app->text_parts, app->icon.c_str(), app->icon_color, this->icon_font_,
                                              app->duration);
     } else if (!app->draw_objects.empty()) {
+      if (!this->anim_started_) {
+        this->anim_started_ = true;
+        this->anim_start_ms_ = this->anim_clock_.frame_time();
+      }
       it.filled_rectangle(0, 0, it.get_width(), it.get_height(), Color(0, 0, 0));
-      done = this->drawDrawObjectsWithIcon(it, this->app_font_, app->draw_objects, app->icon, this->icon_font_,
-                                           app->icon_color);
+      done = this->drawDrawObjectsWithIcon(it, this->app_font_, app->draw_objects, app->icon.c_str(),
+                                           this->icon_font_, app->icon_color, app->duration);
     } else {
       if (app->name == "__date__") {
         done = drawTodayDate(it, this->app_font_, 0, 52);
       } else {
-        done = this->drawScrollingTextWithIcon(it, app->body, app->color, app->icon, app->icon_color, this->app_font_,
-                                               this->icon_font_, app->duration);
+        done = this->drawScrollingTextWithIcon(it, app->body.c_str(), app->color, app->icon.c_str(), app->icon_color,
+                                               this->app_font_, this->icon_font_, app->duration);
       }
     }
 
@@ -1291,8 +2121,143 @@ void DisplayTools::render_app_screen(display::Display &it) {
 }
 
 void DisplayTools::render_screen(display::Display &it) {
-  render_main_screen(it);
-  render_app_screen(it);
+  // Раз на boot_frame_interval_ms_ проганяємо кадр через проксі із захопленням.
+  // Кадр з алертом не зберігаємо — після ребуту він буде неактуальний.
+  const uint32_t start_us = micros();
+  this->anim_clock_.tick();
+  this->apply_render_schedule_(it);
+  this->anim_clock_.set_nominal_interval(it.get_update_interval());
+  this->update_time_cache_();
+
+  // Усе малюється через проксі: кольоровий етап застосовується один раз на піксель.
+  const uint32_t now = this->anim_clock_.frame_time();
+  const bool capture = this->boot_frame_enabled_ && !this->hasAlert() &&
+                       now - this->last_boot_frame_capture_ >= this->boot_frame_interval_ms_;
+  this->frame_proxy_.set_target(&it);
+  this->frame_proxy_.set_color_stage(&this->color_stage_);
+  if (capture) {
+    this->last_boot_frame_capture_ = now;
+    this->frame_proxy_.begin_capture();
+  } else if (this->frame_trace_enabled_) {
+    this->frame_proxy_.restart_capture();
+  }
+
+  render_main_screen(this->frame_proxy_);
+  render_app_screen(this->frame_proxy_);
+
+  const uint32_t frame_crc = this->frame_trace_enabled_ ? this->frame_proxy_.capture_crc() : 0;
+  if (capture)
+    this->save_boot_frame_(this->frame_proxy_.end_capture());
+
+  const uint32_t render_us = micros() - start_us;
+  this->frame_counter_++;
+  if (this->frame_trace_enabled_) {
+    if (this->frame_trace_.size() >= FRAME_TRACE_DEPTH) {
+      this->frame_trace_.pop_front();
+      this->frame_trace_dropped_++;
+    }
+    this->frame_trace_.push_back({this->frame_counter_, now, frame_crc, render_us});
+  }
+
+  // Облік навантаження і пейсингу: частка часу в рендері, інтервали кадрів за вікно ~10 с
+  this->render_busy_us_ += render_us;
+  if (now - this->render_window_start_ >= 10000) {
+    this->render_load_ = this->render_busy_us_ / (10.0f * (now - this->render_window_start_));
+    this->render_busy_us_ = 0;
+    this->render_window_start_ = now;
+    this->frame_interval_p50_ = this->anim_clock_.interval_percentile(50);
+    this->frame_interval_p99_ = this->anim_clock_.interval_percentile(99);
+    this->skipped_steps_ = this->anim_clock_.skipped_steps();
+    this->frame_stalls_ = this->anim_clock_.stalls();
+    this->anim_clock_.reset_stats();
+  }
+}
+
+size_t DisplayTools::drain_frame_trace(std::string &out) {
+  out.clear();
+  const size_t count = this->frame_trace_.size();
+  char line[80];
+  for (const auto &e : this->frame_trace_) {
+    snprintf(line, sizeof(line), "{\"f\":%u,\"t\":%u,\"crc\":\"%08x\",\"us\":%u}\n", (unsigned) e.frame,
+             (unsigned) e.time_ms, (unsigned) e.crc, (unsigned) e.render_us);
+    out += line;
+  }
+  this->frame_trace_.clear();
+  return count;
+}
+
+void DisplayTools::set_night_mode(bool state) {
+  this->night_mode_state_ = state;
+  this->color_stage_.set_night(state);
+}
+
+void DisplayTools::apply_render_schedule_(display::Display &it) {
+  if (this->night_update_interval_ms_ == 0)
+    return;
+  if (this->day_update_interval_ms_ == 0)
+    this->day_update_interval_ms_ = it.get_update_interval();
+
+  // Уночі рідше оновлюємо панель, але алерт скролимо з денною частотою
+  const uint32_t wanted = (this->night_mode_state_ && !this->hasAlert()) ? this->night_update_interval_ms_
+                                                                          : this->day_update_interval_ms_;
+  if (wanted == this->applied_update_interval_ms_)
+    return;
+  this->applied_update_interval_ms_ = wanted;
+  it.set_update_interval(wanted);
+  it.start_poller();  // перезапускає інтервал "update" з новим періодом
+  ESP_LOGD(TAG, "Display update interval: %u ms", (unsigned) wanted);
+}
+
+void DisplayTools::set_brightness(float brightness) {
+  // number від hub75 віддає 0..255
+  this->color_stage_.set_brightness(static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, brightness))));
+}
+
+void DisplayTools::invalidate_text_widths_() {
+  // Шрифт змінився: ширини частин тексту переміряються на наступному кадрі
+  for (auto &app : this->apps_)
+    for (auto &part : app.text_parts)
+      part.width = -1;
+}
+
+bool DisplayTools::has_time() const {
+  // pcf8563 і sntp синхронізують один системний час, тож валідний clock_time_
+  // з'являється одразу після читання RTC, без очікування SNTP
+  return this->clock_time_ != nullptr && this->clock_time_->now().is_valid();
+}
+
+void DisplayTools::render_boot_screen(display::Display &it) {
+  if (this->has_time()) {
+    if (!this->boot_frame_.empty()) {
+      this->boot_frame_.clear();
+      this->boot_frame_.shrink_to_fit();
+    }
+    render_screen(it);
+    return;
+  }
+
+  if (!this->boot_frame_.empty() &&
+      FrameProxy::draw_frame_rle(it, this->boot_frame_.data(), this->boot_frame_.size()))
+    return;
+
+  if (this->app_font_ != nullptr)
+    it.print((it.get_width() / 2), (it.get_height() / 2), this->app_font_, TextAlign::CENTER, "=Loading=");
+}
+
+void DisplayTools::save_boot_frame_(const std::vector<uint8_t> &blob) {
+  if (blob.empty() || this->boot_frame_store_ == nullptr)
+    return;
+  const uint32_t crc = snapshot_crc32(blob.data(), blob.size());
+  if (crc == this->last_boot_frame_crc_)
+    return;
+  if (blob.size() > DISPLAY_TOOLS_BOOT_FRAME_SIZE) {
+    ESP_LOGD(TAG, "Boot frame too large to keep (%u bytes)", (unsigned) blob.size());
+    return;
+  }
+  if (this->boot_frame_store_->save(blob.data(), blob.size())) {
+    this->last_boot_frame_crc_ = crc;
+    ESP_LOGD(TAG, "Saved boot frame (%u bytes)", (unsigned) blob.size());
+  }
 }
 
 std::vector<DisplayTools::ColoredWord> DisplayTools::make_colored_words(const std::vector<std::string> &texts,
@@ -1308,8 +2273,8 @@ std::vector<DisplayTools::ColoredWord> DisplayTools::make_colored_words(const st
     const std::string &c = (i < colors.size()) ? colors[i] : std::string("FFFFFF");
 
     const bool is_icon = (t.rfind(mdi_prefix, 0) == 0);
-    out.push_back(
-        ColoredWord{is_icon ? std::string(get_icon_char(t)) : t, hex_to_color(c), is_icon ? icon_font : text_font});
+    out.push_back(ColoredWord{is_icon ? PayloadString(get_icon_char(t)) : PayloadString(t.data(), t.size()),
+                              hex_to_color(c), is_icon ? icon_font : text_font, PayloadString(), -1, 0});
   }
   return out;
 }
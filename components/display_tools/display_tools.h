@@ -6,10 +6,18 @@
 #include "esphome/components/display/display.h"
 #include "esphome/components/time/real_time_clock.h"
 #include "esphome/core/automation.h"
+#include "snapshot.h"
+#include "frame_proxy.h"
+#include "anim_clock.h"
+#include "span_font.h"
+#include "app_arena.h"
+#include "bitmap_store.h"
+#include "bitmap_animation.h"
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <queue>
+#include <deque>
 #include <map>
 #include <unordered_map>
 #include <algorithm>
@@ -50,7 +58,8 @@ enum class DrawCommandType {
   TEXT,
   CIRCLE,
   FILLED_CIRCLE,
-  BITMAP
+  BITMAP,
+  ANIMATION  // бітмапа (ключовий кадр) + animation
 };
 
 struct DrawObject {
@@ -59,39 +68,63 @@ struct DrawObject {
   int x2 = 0, y2 = 0;
   int x3 = 0, y3 = 0;
   Color color = Color::WHITE;
-  std::string text;          // для TEXT
+  PayloadString text;        // для TEXT
   BaseFont *font = nullptr;  // для TEXT
   TextAlign align = TextAlign::TOP_LEFT;
   std::vector<uint8_t> bitmap_data;  // Зберігає дані для бітової карти
+  // Після addApp дані переїжджають у BitmapStore: bitmap_data звільняється, лишається вказівник
+  const uint8_t *bitmap = nullptr;
+  uint32_t bitmap_size = 0;
+  // CRC32 вмісту; якщо bitmap_data порожній, addApp бере бітмапу зі сховища за цим хешем
+  uint32_t bitmap_hash = 0;
+  // Для ANIMATION: кадри змін поверх ключової бітмапи (x2/y2 — її розмір)
+  std::shared_ptr<BitmapAnimation> animation;
+  PayloadString id;  // для patch_*; порожній — лише за індексом
+
+  const uint8_t *bitmap_ptr() const { return this->bitmap != nullptr ? this->bitmap : this->bitmap_data.data(); }
+  size_t bitmap_len() const { return this->bitmap != nullptr ? this->bitmap_size : this->bitmap_data.size(); }
 };
 
 class DisplayTools : public Component {
  public:
   struct ColoredWord {
-    std::string text;
+    PayloadString text;
     Color color;
     BaseFont *font = nullptr;
+    PayloadString id;    // для patch_text_part*; порожній — лише за індексом
+    int16_t width = -1;  // виміряна ширина з відступом; -1 — виміряти при наступному кадрі
+    int16_t height = 0;
   };
 
   struct ScrollingState {
-    int16_t xpos = -1;
+    int xpos = -1;
     int16_t repeat = 0;
     bool scrolling = false;
     std::string last_text;
-    int frame_hold = 0;
+    int text_width = 0;
+    int text_height = 0;
+    uint32_t hold_start_ms = 0;  // час годинника анімацій
+    uint32_t step_accum_ms = 0;  // залишок фіксованого кроку скролу
+    bool relayout = false;       // текст змінив patch: позиція і час показу лишаються, якщо режим той самий
   };
 
   struct App_Info {
-    std::string name;
-    std::string body;
+    std::string name;  // ключ, переживає оновлення — поза ареною
+    // Арена вантажу: рядки і вектори нижче виділені з неї і звільняються разом з нею,
+    // коли app оновлюють або видаляють. Без арени (копії, декодований знімок) — купа
+    PayloadAllocator<char> payload;
+    PayloadString body;
     Color color = Color::WHITE;
     uint16_t duration = 2;
-    std::string icon;
+    PayloadString icon;
     Color icon_color = Color::WHITE;
-    std::vector<ColoredWord> text_parts;
-    std::vector<DrawObject> draw_objects;
+    PayloadVector<ColoredWord> text_parts;
+    PayloadVector<DrawObject> draw_objects;
     uint16_t index = 0;
     ScrollingState scroll;
+    uint32_t bytes = 0;       // оцінка пам'яті, яку тримає app (app_bytes_)
+    uint32_t last_shown = 0;  // час годинника анімацій, коли app востаннє став поточним (для LRU)
+    std::vector<BitmapStore::Ref> bitmaps;  // посилання на бітмапи draw_objects у спільному сховищі
   };
 
   struct AlertMessage {
@@ -102,12 +135,19 @@ class DisplayTools : public Component {
     std::string sound{"14"};  // просто рядок-ідентифікатор
     uint16_t repeat{1};
     ScrollingState scroll;
+    uint32_t bytes{0};
   };
 
   Trigger<int> *get_on_play_trigger() { return this->on_play_trigger_; }
+  // Синхронізація з плеєром: on_play_sound ставить звук, а плеєр після OK на PLAYNUM викликає
+  // notify_sound_started(true) (або false, якщо команду не прийнято/не виконано).
+  // 0 = не чекати; інакше перший крок алерту тримається до підтвердження, але не довше за timeout.
+  void set_sound_sync_timeout(uint32_t ms) { this->sound_sync_timeout_ms_ = ms; }
+  void notify_sound_started(bool ok);
 
   // ---------- Життєвий цикл ESPHome ----------
   void setup() override;
+  void loop() override;
   void dump_config() override;
 
   // --- API ---
@@ -115,24 +155,69 @@ class DisplayTools : public Component {
   void render_app_screen(display::Display &it);
 
   void render_screen(display::Display &it);
+  // Сторінка завантаження: живий рендер, щойно є час (RTC або SNTP), до того — збережений кадр
+  void render_boot_screen(display::Display &it);
+  bool has_time() const;
 
   // --- setters ---
-  void set_night_mode(bool state) { this->night_mode_state_ = state; }
+  // Нічний режим = палітра в ColorStage + полегшений розклад рендеру
+  void set_night_mode(bool state);
+  void set_night_update_interval(uint32_t ms) { this->night_update_interval_ms_ = ms; }
+  void set_night_level(uint8_t level) { this->color_stage_.set_night_level(level); }
+  // Частка часу (%), яку займає render_screen, за останнє вікно ~10 с
+  float get_render_load() const { return this->render_load_; }
+  // Пейсинг кадрів за те саме вікно: інтервал між кадрами p50/p99 (мс), пропущені кроки скролу, зависання > 250 мс
+  uint32_t get_frame_interval_p50() const { return this->frame_interval_p50_; }
+  uint32_t get_frame_interval_p99() const { return this->frame_interval_p99_; }
+  uint32_t get_skipped_steps() const { return this->skipped_steps_; }
+  uint32_t get_frame_stalls() const { return this->frame_stalls_; }
   void set_clock_time(esphome::time::RealTimeClock *clock) { this->clock_time_ = clock; }
   // void set_dfplayer(esphome::dfplayer_pro::DFPlayerPro *player) { this->dfplayer_ = player; }
 
   void set_clock_font(display::BaseFont *f) { this->clock_font_ = f; }
-  void set_app_font(display::BaseFont *f) { this->app_font_ = f; }
+  void set_app_font(display::BaseFont *f) {
+    this->app_font_ = f;
+    this->span_font_.clear();
+    this->invalidate_text_widths_();
+  }
+  // 1bpp-шрифт додатково розкладається на відрізки — текст apps/alerts малюється швидким шляхом
+  void set_app_font(font::Font *f) {
+    this->app_font_ = f;
+    this->span_font_.build(f);
+    this->invalidate_text_widths_();
+  }
   void set_icon_font(display::BaseFont *f) { this->icon_font_ = f; }
   void set_extra_font(display::BaseFont *f) { this->extra_font_ = f; }
 
   // void set_scroll_speed(float speed) { this->scroll_speed_ = speed; }
 
+  // --- знімок apps у флеш ---
+  void set_persist_apps(bool v) { this->persist_apps_ = v; }
+  void set_snapshot_interval(uint32_t ms) { this->snapshot_interval_ms_ = ms; }
+  void set_snapshot_store(SnapshotStore *store) { this->snapshot_store_ = store; }
+  // Кольоровий етап: гамма і яскравість панелі (для підлоги видимих рівнів)
+  void set_gamma(float gamma) { this->color_stage_.set_gamma(gamma); }
+  void set_brightness(float brightness);
+  void set_boot_frame(bool v) { this->boot_frame_enabled_ = v; }
+  void set_boot_frame_interval(uint32_t ms) { this->boot_frame_interval_ms_ = ms; }
+  void set_boot_frame_store(SnapshotStore *store) { this->boot_frame_store_ = store; }
+
+  // --- трасування кадрів (запис/реплей MQTT-сесій) ---
+  // Кожен кадр: CRC32 фінальних пікселів (після ColorStage) і час рендеру в мкс
+  void set_frame_trace(bool v) { this->frame_trace_enabled_ = v; }
+  // Детермінований годинник для реплею: фіксований крок кадру і епоха настінного часу
+  void set_replay_frame_step(uint32_t ms) { this->anim_clock_.set_fixed_step(ms); }
+  void set_replay_epoch(uint32_t epoch) { this->anim_clock_.set_epoch(epoch); }
+  // Забирає накопичені записи як JSON Lines: {"f":N,"t":ms,"crc":"hex","us":N}; повертає кількість
+  size_t drain_frame_trace(std::string &out);
+  uint32_t get_frame_trace_dropped() const { return this->frame_trace_dropped_; }
+
   void set_temperature_outside(float temp) { this->temperature_outside_ = temp; }
   void set_temperature_inside(float temp) { this->temperature_inside_ = temp; }
   void set_weather_icon(const std::string &icon) { this->weather_icon_ = icon; }
 
-  void set_temperature_progress(const std::vector<int> &progress) { this->temperature_progress_ = progress; }
+  // Рядок градієнта прогнозу рахується тут один раз; кадр лише виводить готові кольори
+  void set_temperature_progress(const std::vector<int> &progress);
   const std::vector<int> &get_temperature_progress() const { return this->temperature_progress_; }
 
   void set_top_left(bool v) { set_corner_state(Corner::TOP_LEFT, v); }
@@ -147,6 +232,9 @@ class DisplayTools : public Component {
   // float get_scroll_speed() const { return scroll_speed_; }
 
   bool get_night_mode() const { return night_mode_state_; }
+
+  // Годинник анімацій: джерело часу можна підмінити (тести, реплей)
+  AnimationClock &get_animation_clock() { return this->anim_clock_; }
   // ======================================================================
   //                        КЕРУВАННЯ ДОДАТКАМИ (apps)
   // ======================================================================
@@ -156,9 +244,39 @@ class DisplayTools : public Component {
               std::vector<DrawObject> draw_objects = {});
   bool delApp(const std::string &name);
   void nextApp();
+  // Бюджет пам'яті на apps і їхні бітмапи (байти, оцінка); 0 = без обмеження.
+  // При перевищенні витісняється app, що найдовше не показувався (крім __date__ і поточного).
+  // Черга алертів у бюджет не входить: у неї своя межа MAX_QUEUED_ALERTS
+  void set_memory_budget(uint32_t bytes) { this->memory_budget_ = bytes; }
+  uint32_t get_memory_budget() const { return this->memory_budget_; }
+  // Усе разом, з чергою алертів; спільні бітмапи рахуються один раз, скільки б apps на них не посилались
+  uint32_t get_memory_used() const { return this->get_apps_memory_used_() + this->alerts_bytes_; }
+  uint32_t get_evicted_apps() const { return this->evicted_apps_; }
+  uint32_t get_dropped_alerts() const { return this->dropped_alerts_; }
+  // Звідки брати арени вантажу apps і блоки бітмап; за замовчуванням PSRAM, якщо вона є (блок psram: у YAML)
+  void set_payload_backing(ArenaBacking *backing) {
+    this->payload_backing_ = backing;
+    this->bitmap_store_.set_backing(backing);
+  }
+  // Бітмапи apps за вмістом: відправник може послатися на вже відому бітмапу її CRC32
+  const BitmapStore &get_bitmap_store() const { return this->bitmap_store_; }
+  uint32_t get_missing_bitmaps() const { return this->missing_bitmaps_; }
   App_Info *getCurrentApp();
   void reorderAppsByIndex();
 
+  // Часткові оновлення app без повного addApp: решта вмісту, виміряні ширини і бітмапи лишаються.
+  // ref — id елемента або, якщо такого id немає, його індекс ("0", "1", ...).
+  // false — app або елемент не знайдено чи зміна не підходить елементу
+  bool patch_text_part(const std::string &app, const std::string &ref, const std::string &text);
+  bool patch_text_part_color(const std::string &app, const std::string &ref, Color color);
+  bool patch_draw_object_color(const std::string &app, const std::string &ref, Color color);
+  bool patch_draw_object_text(const std::string &app, const std::string &ref, const std::string &text);
+  // Перші count координат у порядку x1 y1 x2 y2 x3 y3 (у бітмап x2/y2 — розмір, їх не змінити)
+  bool patch_draw_object_coords(const std::string &app, const std::string &ref, const int *coords, size_t count);
+  // Прямокутник x,y,w,h усередині BITMAP, rgb — w*h*3 байт; спільна бітмапа інших apps не змінюється
+  bool patch_bitmap_region(const std::string &app, const std::string &ref, int x, int y, int w, int h,
+                           const uint8_t *rgb, size_t size);
+
   // ======================================================================
   //                      ЧЕРГА АЛЕРТІВ (було у тебе)
   // ======================================================================
@@ -176,10 +294,21 @@ class DisplayTools : public Component {
                                                             const std::vector<std::string> &colors, BaseFont *text_font,
                                                             BaseFont *icon_font);
 
-  std::string get_app_loop();
+  // Стан для MQTT: документ і дельта будуються лише після зміни лічильників поколінь
+  const std::string &get_app_loop();
+  bool app_loop_changed();
+  bool get_app_loop_delta(std::string &out);
+  uint32_t get_apps_generation() const { return this->apps_generation_; }
+  uint32_t get_alerts_generation() const { return this->alerts_generation_; }
 
   static Color hex_to_color(const std::string &hex);
 
+  // Бінарний знімок реєстру apps (версійований, з CRC32). Публічні, щоб перевіряти round-trip
+  std::vector<uint8_t> encode_apps_snapshot() const;
+  bool decode_apps_snapshot(const uint8_t *data, size_t len, std::vector<App_Info> &out) const;
+  bool save_apps_snapshot();
+  bool restore_apps_snapshot();
+
   // ======================================================================
   //                           КІНЕЦЬ ПУБЛІЧНОГО API
   // ======================================================================
@@ -191,13 +320,38 @@ class DisplayTools : public Component {
 
   // state
   bool night_mode_state_{false};
-  int tick_counter_{0};
+  uint32_t night_update_interval_ms_{0};  // 0 = не змінювати частоту вночі
+  uint32_t day_update_interval_ms_{0};
+  uint32_t applied_update_interval_ms_{0};
+  uint32_t render_busy_us_{0};
+  uint32_t render_window_start_{0};
+  float render_load_{0};
+  uint32_t frame_interval_p50_{0};
+  uint32_t frame_interval_p99_{0};
+  uint32_t skipped_steps_{0};
+  uint32_t frame_stalls_{0};
   bool first_alert_play_{true};
 
+  // Старт алерту: зсув між першим кроком тексту і підтвердженням звуку (час годинника анімацій)
+  struct AlertSync {
+    bool awaiting_sound = false;  // звук запитано, підтвердження ще немає
+    uint32_t requested_ms = 0;
+    bool visual_started = false;
+    uint32_t visual_ms = 0;
+    bool audio_started = false;
+    uint32_t audio_ms = 0;
+  };
+  AlertSync alert_sync_;
+  uint32_t sound_sync_timeout_ms_{0};
+  bool alert_hold_{false};  // перший крок алерту ще тримається
+  void log_alert_sync_();
+
   float temperature_outside_{NAN};
   float temperature_inside_{NAN};
   std::string weather_icon_;
   std::vector<int> temperature_progress_;
+  static constexpr int FORECAST_ROW_WIDTH = 128;  // ширина панелі; інша ширина перерахується при малюванні
+  std::vector<Color> forecast_row_;
 
   // external deps
   esphome::time::RealTimeClock *clock_time_{nullptr};
@@ -217,10 +371,142 @@ class DisplayTools : public Component {
   static constexpr Color YELLOW = Color(0xFFFF00);
   static constexpr Color ORANGE = Color(0xFFA500);
 
+  // ---------- Анімації ----------
+  static constexpr uint32_t SCROLL_STEP_MS = 10;         // 100 px/с
+  static constexpr uint32_t HOLD_MS_PER_REPEAT = 2000;  // пауза на один повтор статичного тексту
+  AnimationClock anim_clock_;
+  ScrollingState text_scroll_;
+  ScrollingState parts_scroll_;
+  struct PagedState {
+    std::vector<std::string> pages;
+    size_t current_page = 0;
+    std::string last_text;
+    uint32_t hold_start_ms = 0;
+  } paged_;
+  bool date_hold_active_{false};
+  uint32_t date_hold_start_{0};
+  bool draw_hold_active_{false};
+  uint32_t draw_hold_start_{0};
+  // Початок показу поточного app: від нього рахуються кадри ANIMATION
+  bool anim_started_{false};
+  uint32_t anim_start_ms_{0};
+
+  // ---------- Анімовані бітмапи ----------
+  // Один робочий буфер на всі анімації: у ньому лежить останній розгорнутий кадр
+  std::vector<uint8_t> anim_scratch_;
+  uint32_t anim_scratch_id_{0};
+  size_t anim_scratch_frame_{0};
+  // Кадр frame анімації obj (ключовий — без копіювання); nullptr, якщо бітмапи немає
+  const uint8_t *animation_frame_(const DrawObject &obj, size_t frame);
+
+  // ---------- Трасування кадрів ----------
+  struct FrameTraceEntry {
+    uint32_t frame;
+    uint32_t time_ms;
+    uint32_t crc;
+    uint32_t render_us;
+  };
+  static constexpr size_t FRAME_TRACE_DEPTH = 256;  // ~2 с кадрів при 8 мс; далі найстаріші відкидаються
+  bool frame_trace_enabled_{false};
+  uint32_t frame_counter_{0};
+  uint32_t frame_trace_dropped_{0};
+  std::deque<FrameTraceEntry> frame_trace_;
+
+  // ---------- Кеш часу (спільний для всіх рендерів) ----------
+  // Системний час спільний для pcf8563 і sntp, тож читаємо ::time() замість RealTimeClock::now()
+  struct TimeCache {
+    time_t second{-1};
+    int minute_key{-1};
+    int day_key{-1};
+    char clock_colon[6]{};  // "HH:MM"
+    char clock_blank[6]{};  // "HH MM"
+    char day_digits[3]{};
+    int weekday{0};  // пн=0 ... нд=6
+    std::string month_upper;
+    int month_width{-1};
+    BaseFont *month_width_font{nullptr};
+  };
+  TimeCache time_cache_;
+  void update_time_cache_();
+
   // ---------- Стан (раніше глобальні) ----------
+  // Сховища оголошені раніше за apps_: бітмапи й арени вантажу звільняються в них під час знищення apps_
+#ifdef USE_PSRAM
+  RamArenaBacking default_payload_backing_{true};
+#else
+  RamArenaBacking default_payload_backing_{false};
+#endif
+  ArenaBacking *payload_backing_{&default_payload_backing_};
+  BitmapStore bitmap_store_{&default_payload_backing_};
+  uint32_t missing_bitmaps_{0};
   std::vector<App_Info> apps_;
   size_t current_app_index_{npos};
-  std::queue<AlertMessage> alert_messages_queue_;
+  std::deque<AlertMessage> alert_messages_queue_;
+  static constexpr size_t MAX_QUEUED_ALERTS = 8;  // разом з тим, що на екрані
+
+  // ---------- Облік пам'яті ----------
+  uint32_t memory_budget_{0};
+  uint32_t apps_bytes_{0};
+  uint32_t alerts_bytes_{0};
+  uint32_t evicted_apps_{0};
+  uint32_t dropped_alerts_{0};
+  uint32_t get_apps_memory_used_() const { return this->apps_bytes_ + this->bitmap_store_.bytes(); }
+  static size_t app_bytes_(const App_Info &app);
+  static size_t alert_bytes_(const AlertMessage &alert);
+  void enforce_memory_budget_();
+  void invalidate_text_widths_();
+  // Вантаж app у нову арену під його точний розмір; попередня звільняється, коли її відпустить останній рядок
+  void set_payload_(App_Info &app, std::string_view body, std::string_view icon,
+                    std::vector<ColoredWord> text_parts, std::vector<DrawObject> draw_objects);
+  // Переносить бітмапи app у сховище (або знаходить їх там за хешем); старі посилання відпускає
+  void adopt_payload_(App_Info &app);
+
+  // ---------- Знімок apps ----------
+  static constexpr uint8_t SNAPSHOT_VERSION = 3;
+  static constexpr uint32_t SNAPSHOT_QUIET_MS = 5000;  // чекаємо, поки серія оновлень по MQTT вщухне
+  bool persist_apps_{false};
+  uint32_t snapshot_interval_ms_{60000};  // не частіше, ніж раз на стільки
+  SnapshotStore *snapshot_store_{nullptr};
+  std::unique_ptr<SnapshotStore> own_snapshot_store_;
+  bool snapshot_dirty_{false};
+  uint32_t snapshot_dirty_since_{0};
+  uint32_t last_snapshot_write_{0};
+  uint32_t last_snapshot_crc_{0};
+
+  // ---------- Кадр для миттєвого старту ----------
+  bool boot_frame_enabled_{false};
+  uint32_t boot_frame_interval_ms_{600000};
+  uint32_t last_boot_frame_capture_{0};
+  uint32_t last_boot_frame_crc_{0};
+  SnapshotStore *boot_frame_store_{nullptr};
+  std::unique_ptr<SnapshotStore> own_boot_frame_store_;
+  std::vector<uint8_t> boot_frame_;  // тримаємо лише до першого живого кадру
+  FrameProxy frame_proxy_;
+  SpanFont span_font_;
+  // it.print(...), але шрифт app_font_ через проксі йде відрізками SpanFont
+  void print_text_(Display &it, int x, int y, BaseFont *font, Color color, TextAlign align, const char *text);
+  ColorStage color_stage_;
+
+  void save_boot_frame_(const std::vector<uint8_t> &blob);
+  void apply_render_schedule_(display::Display &it);
+
+  // ---------- Покоління стану (для публікації змін) ----------
+  uint32_t apps_generation_{0};
+  uint32_t alerts_generation_{0};
+  std::string app_loop_cache_;
+  uint32_t app_loop_cache_gen_{0};
+  uint32_t app_loop_published_gen_{0};
+  uint32_t delta_apps_gen_{0};
+  uint32_t delta_alerts_gen_{0};
+  std::vector<std::string> delta_names_;
+  std::string delta_current_;
+
+  static void append_json_string_(std::string &out, const std::string &value);
+  void on_apps_changed_();
+  // Після patch_*: облік пам'яті, знімок; app-loop оновлюється лише якщо змінився розмір
+  void on_app_patched_(App_Info &app);
+  uint8_t font_role_(const BaseFont *font) const;
+  BaseFont *font_from_role_(uint8_t role) const;
 
   // ---------- Приватні хелпери ----------
   App_Info *getAppByName_(const std::string &name);
@@ -235,8 +521,9 @@ class DisplayTools : public Component {
   static const char *get_icon_char(const std::string &icon_name);
   static std::string truncate_utf8_string(const std::string &str, size_t max_len);
   static std::string getLastSegment(const std::string &topic);
-  static Color hsv_to_rgb(float h, float s, float v);
   static Color get_temp_color(float temp);
+  static Color get_temp_ramp_color(float temp);
+  void build_forecast_row_(int width);
   static std::string to_upper(const std::string &input);
   static std::string cyr_upper(const std::string &str);
 
@@ -244,18 +531,18 @@ class DisplayTools : public Component {
   //                          МАЛЮВАЛКИ (як у тебе)
   // ======================================================================
   bool drawTodayDate(Display &it, BaseFont *font, int xpos, int ypos);
-  bool drawScrollingTextWithIcon(Display &it, const std::string &text, const Color &textColor, const std::string &icon,
+  bool drawScrollingTextWithIcon(Display &it, const char *text, const Color &textColor, const char *icon,
                                  const Color &iconColor, BaseFont *fontText, BaseFont *fontIcon, int repeat);
-  bool drawScrollingTextWithIcon(Display &it, const std::vector<ColoredWord> &textParts, const std::string &icon,
+  bool drawScrollingTextWithIcon(Display &it, PayloadVector<ColoredWord> &textParts, const char *icon,
                                  const Color &iconColor, BaseFont *fontIcon, int repeat);
   bool drawPagedTextWithIcon(Display &it, const std::string &text, const Color &textColor, const std::string &icon,
                              const Color &iconColor, BaseFont *fontText, BaseFont *fontIcon, int repeat);
-  bool drawDrawObjects(Display &it, BaseFont *textFont, const std::vector<DrawObject> &objects);
-  bool drawDrawObjectsWithIcon(Display &it, BaseFont *textFont, const std::vector<DrawObject> &objects,
-                               const std::string &icon, BaseFont *iconFont, const Color &iconColor);
-  void draw_colored_line(esphome::display::Display &it, std::vector<int> temp_forecast, bool night_mode_state);
+  bool drawDrawObjects(Display &it, BaseFont *textFont, const PayloadVector<DrawObject> &objects, int dx = 0);
+  bool drawDrawObjectsWithIcon(Display &it, BaseFont *textFont, const PayloadVector<DrawObject> &objects,
+                               const char *icon, BaseFont *iconFont, const Color &iconColor, int repeat);
+  void draw_colored_line(esphome::display::Display &it);
   void draw_alert_corner(Display &it, Corner corner, const Color &color);
-  void draw_bitmap_from_vector(Display &it, int x, int y, int w, int h, const std::vector<uint8_t> &bmp_data);
+  void draw_bitmap_from_vector(Display &it, int x, int y, int w, int h, const uint8_t *bmp_data, size_t size);
 
   void emit_on_play_sound(int no) {
     if (on_play_trigger_)
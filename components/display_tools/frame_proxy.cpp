@@ -0,0 +1,146 @@
+// frame_proxy.cpp
+#include "frame_proxy.h"
+#include "snapshot.h"
+
+namespace esphome {
+namespace display_tools {
+
+static const uint8_t FRAME_VERSION = 1;
+
+void FrameProxy::begin_capture() {
+  this->capture_w_ = this->get_width();
+  this->capture_h_ = this->get_height();
+  if (this->capture_w_ <= 0 || this->capture_h_ <= 0)
+    return;
+  // Панель очищається перед кожним кадром, тож стартуємо з чорного
+  this->capture_.reset(new uint16_t[this->capture_w_ * this->capture_h_]());
+}
+
+std::vector<uint8_t> FrameProxy::end_capture() {
+  std::vector<uint8_t> out;
+  if (this->capture_ != nullptr)
+    out = encode_frame_rle(this->capture_.get(), this->capture_w_, this->capture_h_);
+  this->capture_.reset();
+  return out;
+}
+
+void FrameProxy::restart_capture() {
+  if (this->capture_ == nullptr || this->capture_w_ != this->get_width() || this->capture_h_ != this->get_height()) {
+    this->begin_capture();
+    return;
+  }
+  std::fill_n(this->capture_.get(), this->capture_w_ * this->capture_h_, 0);
+}
+
+uint32_t FrameProxy::capture_crc() const {
+  if (this->capture_ == nullptr)
+    return 0;
+  // Порядок байтів як у RLE-форматі (little-endian), щоб CRC не залежала від платформи
+  uint32_t crc = 0xFFFFFFFF;
+  const int total = this->capture_w_ * this->capture_h_;
+  for (int i = 0; i < total; i++) {
+    const uint8_t px[2] = {static_cast<uint8_t>(this->capture_[i]), static_cast<uint8_t>(this->capture_[i] >> 8)};
+    crc = snapshot_crc32_update(crc, px, 2);
+  }
+  return ~crc;
+}
+
+void HOT FrameProxy::draw_pixel_at(int x, int y, Color color) {
+  if (this->target_ == nullptr || !this->get_clipping().inside(x, y))
+    return;
+  const Color out = this->stage_ != nullptr ? this->stage_->apply(color) : color;
+  this->target_->draw_pixel_at(x, y, out);
+  if (this->capture_ != nullptr && x >= 0 && y >= 0 && x < this->capture_w_ && y < this->capture_h_)
+    this->capture_[y * this->capture_w_ + x] = to_565(out);
+}
+
+void HOT FrameProxy::draw_span(int x, int y, int len, Color color) {
+  if (this->target_ == nullptr || len <= 0)
+    return;
+  int x0 = std::max(x, 0), x1 = std::min(x + len, this->get_width());
+  if (y < 0 || y >= this->get_height())
+    return;
+  if (this->is_clipping()) {
+    const display::Rect clip = this->get_clipping();
+    if (y < clip.y || y >= clip.y2())
+      return;
+    x0 = std::max<int>(x0, clip.x);
+    x1 = std::min<int>(x1, clip.x2());
+  }
+  if (x0 >= x1)
+    return;
+  const Color out = this->stage_ != nullptr ? this->stage_->apply(color) : color;
+  for (int px = x0; px < x1; px++)
+    this->target_->draw_pixel_at(px, y, out);
+  if (this->capture_ != nullptr && y < this->capture_h_ && x0 < this->capture_w_) {
+    const uint16_t v = to_565(out);
+    std::fill(this->capture_.get() + y * this->capture_w_ + x0,
+              this->capture_.get() + y * this->capture_w_ + std::min(x1, this->capture_w_), v);
+  }
+}
+
+std::vector<uint8_t> FrameProxy::encode_frame_rle(const uint16_t *pixels, int w, int h) {
+  std::vector<uint8_t> out;
+  out.reserve(512);
+  ByteWriter wr(out);
+  wr.u8('D');
+  wr.u8('T');
+  wr.u8('F');
+  wr.u8('B');
+  wr.u8(FRAME_VERSION);
+  wr.u16(w);
+  wr.u16(h);
+
+  const int total = w * h;
+  for (int i = 0; i < total;) {
+    const uint16_t v = pixels[i];
+    int run = 1;
+    while (run < 255 && i + run < total && pixels[i + run] == v)
+      run++;
+    wr.u8(run);
+    wr.u16(v);
+    i += run;
+  }
+  wr.u32(snapshot_crc32(out.data(), out.size()));
+  return out;
+}
+
+bool FrameProxy::draw_frame_rle(display::Display &it, const uint8_t *data, size_t len) {
+  if (len < 9 + 4)
+    return false;
+  const size_t body_len = len - 4;
+  ByteReader crc_r(data + body_len, 4);
+  if (snapshot_crc32(data, body_len) != crc_r.u32())
+    return false;
+
+  ByteReader r(data, body_len);
+  if (r.u8() != 'D' || r.u8() != 'T' || r.u8() != 'F' || r.u8() != 'B' || r.u8() != FRAME_VERSION)
+    return false;
+  const int w = r.u16();
+  const int h = r.u16();
+  if (w <= 0 || h <= 0)
+    return false;
+
+  int pos = 0;
+  while (r.remaining() >= 3 && pos < w * h) {
+    int run = r.u8();
+    const uint16_t v = r.u16();
+    if (v == 0) {
+      pos += run;
+      continue;
+    }
+    const Color c = from_565(v);
+    // відрізок може переходити на наступний рядок
+    while (run > 0 && pos < w * h) {
+      const int x = pos % w, y = pos / w;
+      const int span = std::min(run, w - x);
+      it.horizontal_line(x, y, span, c);
+      pos += span;
+      run -= span;
+    }
+  }
+  return r.ok();
+}
+
+}  // namespace display_tools
+}  // namespace esphome
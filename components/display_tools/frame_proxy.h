@@ -0,0 +1,63 @@
+// frame_proxy.h
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display/display.h"
+#include "color_stage.h"
+
+#include <memory>
+#include <vector>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// FrameProxy: проміжний дисплей між рендерерами і панеллю.
+// Усі малювалки Display зводяться до draw_pixel_at, тож тут один вхід на піксель:
+// кліпінг, кольоровий етап (ColorStage), пересилання на панель і (за потреби) захоплення кадру в RGB565.
+// ============================================================================
+class FrameProxy : public display::Display {
+ public:
+  void set_target(display::Display *target) { this->target_ = target; }
+  display::Display *get_target() const { return this->target_; }
+  void set_color_stage(const ColorStage *stage) { this->stage_ = stage; }
+
+  // --- захоплення одного кадру ---
+  void begin_capture();
+  bool is_capturing() const { return this->capture_ != nullptr; }
+  // Повертає RLE-блоб кадру (формат див. encode_frame_rle) і звільняє буфер
+  std::vector<uint8_t> end_capture();
+  // Для трасування: почати новий кадр, не звільняючи буфер; CRC32 поточного захопленого кадру
+  void restart_capture();
+  uint32_t capture_crc() const;
+
+  void draw_pixel_at(int x, int y, Color color) override;
+  // Горизонтальний відрізок: кліпінг і кольоровий етап — один раз на відрізок, а не на піксель
+  void draw_span(int x, int y, int len, Color color);
+  display::DisplayType get_display_type() override { return display::DISPLAY_TYPE_COLOR; }
+  void update() override {}
+
+  // Формат v1: "DTFB" | version:u8 | w:u16 | h:u16 | (count:u8 rgb565:u16)* | crc32:u32
+  static std::vector<uint8_t> encode_frame_rle(const uint16_t *pixels, int w, int h);
+  // Малює збережений кадр рядковими відрізками; чорні відрізки пропускає (панель уже очищена)
+  static bool draw_frame_rle(display::Display &it, const uint8_t *data, size_t len);
+
+  static uint16_t to_565(const Color &c) { return ((c.r & 0xF8) << 8) | ((c.g & 0xFC) << 3) | (c.b >> 3); }
+  static Color from_565(uint16_t v) {
+    const uint8_t r = (v >> 11) & 0x1F, g = (v >> 5) & 0x3F, b = v & 0x1F;
+    return Color((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+  }
+
+ protected:
+  int get_width_internal() override { return this->target_ ? this->target_->get_width() : 0; }
+  int get_height_internal() override { return this->target_ ? this->target_->get_height() : 0; }
+
+  display::Display *target_{nullptr};
+  const ColorStage *stage_{nullptr};
+  std::unique_ptr<uint16_t[]> capture_;
+  int capture_w_{0};
+  int capture_h_{0};
+};
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,273 @@
+// snapshot.h
+#pragma once
+
+#include "esphome.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef DISPLAY_TOOLS_SNAPSHOT_SIZE
+#define DISPLAY_TOOLS_SNAPSHOT_SIZE 8192
+#endif
+#ifndef DISPLAY_TOOLS_BOOT_FRAME_SIZE
+#define DISPLAY_TOOLS_BOOT_FRAME_SIZE 4096
+#endif
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// Бінарні знімки стану: запис/читання байтів, CRC32 і бекенди збереження
+// ============================================================================
+
+// Потокова форма: стартове значення 0xFFFFFFFF, результат інвертується наприкінці
+inline uint32_t snapshot_crc32_update(uint32_t crc, const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    crc ^= data[i];
+    for (int b = 0; b < 8; b++)
+      crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+  }
+  return crc;
+}
+
+inline uint32_t snapshot_crc32(const uint8_t *data, size_t len) {
+  return ~snapshot_crc32_update(0xFFFFFFFFu, data, len);
+}
+
+// Little-endian запис у вектор
+class ByteWriter {
+ public:
+  explicit ByteWriter(std::vector<uint8_t> &out) : out_(out) {}
+
+  void u8(uint8_t v) { out_.push_back(v); }
+  void u16(uint16_t v) {
+    out_.push_back(v & 0xFF);
+    out_.push_back(v >> 8);
+  }
+  void i16(int v) { u16(static_cast<uint16_t>(static_cast<int16_t>(v))); }
+  void u32(uint32_t v) {
+    u16(v & 0xFFFF);
+    u16(v >> 16);
+  }
+  void color(const Color &c) {
+    out_.push_back(c.r);
+    out_.push_back(c.g);
+    out_.push_back(c.b);
+  }
+  void str(std::string_view s) {
+    u16(static_cast<uint16_t>(std::min<size_t>(s.size(), 0xFFFF)));
+    out_.insert(out_.end(), s.begin(), s.begin() + std::min<size_t>(s.size(), 0xFFFF));
+  }
+  void bytes(const std::vector<uint8_t> &b) { bytes(b.data(), b.size()); }
+  void bytes(const uint8_t *b, size_t n) {
+    u32(n);
+    out_.insert(out_.end(), b, b + n);
+  }
+
+ protected:
+  std::vector<uint8_t> &out_;
+};
+
+// Читання з перевіркою меж: після першої помилки ok() == false, далі повертає нулі
+class ByteReader {
+ public:
+  ByteReader(const uint8_t *data, size_t len) : data_(data), len_(len) {}
+
+  bool ok() const { return ok_; }
+  size_t remaining() const { return len_ - pos_; }
+
+  uint8_t u8() { return need_(1) ? data_[pos_++] : 0; }
+  uint16_t u16() {
+    if (!need_(2))
+      return 0;
+    uint16_t v = data_[pos_] | (data_[pos_ + 1] << 8);
+    pos_ += 2;
+    return v;
+  }
+  int i16() { return static_cast<int16_t>(u16()); }
+  uint32_t u32() {
+    uint32_t lo = u16();
+    uint32_t hi = u16();
+    return lo | (hi << 16);
+  }
+  Color color() {
+    if (!need_(3))
+      return Color::BLACK;
+    Color c(data_[pos_], data_[pos_ + 1], data_[pos_ + 2]);
+    pos_ += 3;
+    return c;
+  }
+  std::string str() {
+    uint16_t n = u16();
+    if (!need_(n))
+      return {};
+    std::string s(reinterpret_cast<const char *>(data_ + pos_), n);
+    pos_ += n;
+    return s;
+  }
+  std::vector<uint8_t> bytes() {
+    uint32_t n = u32();
+    if (!need_(n))
+      return {};
+    std::vector<uint8_t> b(data_ + pos_, data_ + pos_ + n);
+    pos_ += n;
+    return b;
+  }
+
+ protected:
+  bool need_(size_t n) {
+    if (!ok_ || len_ - pos_ < n)
+      ok_ = false;
+    return ok_;
+  }
+
+  const uint8_t *data_;
+  size_t len_;
+  size_t pos_{0};
+  bool ok_{true};
+};
+
+// ---------- Бекенди ----------
+class SnapshotStore {
+ public:
+  virtual ~SnapshotStore() = default;
+  // Один блоб цілком: одне читання при старті, один запис при збереженні
+  virtual bool load(std::vector<uint8_t> &out) = 0;
+  virtual bool save(const uint8_t *data, size_t len) = 0;
+};
+
+// Preferences (NVS на ESP32). Блоб до N байт ділиться на слоти по CHUNK байт:
+// заголовок (довжина, CRC, кількість слотів) + лише ті слоти, що зайняті даними.
+// Той самий вміст (за CRC) повторно не пишеться; читання йде слот за слотом, без буфера на N.
+// Фактичний запис у флеш робить global_preferences->sync() (flash_write_interval).
+template<size_t N> class PreferencesSnapshotStore : public SnapshotStore {
+ public:
+  static constexpr size_t CHUNK = 256;
+
+  explicit PreferencesSnapshotStore(uint32_t key) : key_(key) {}
+
+  bool load(std::vector<uint8_t> &out) override {
+    this->init_();
+    if (!this->read_header_() || this->header_.length > N || this->header_.chunks != chunks_for_(this->header_.length))
+      return false;
+    out.resize(this->header_.length);
+    Chunk chunk;
+    for (uint16_t i = 0; i < this->header_.chunks; i++) {
+      if (!this->chunk_(i).load(&chunk))
+        return false;
+      const size_t offset = static_cast<size_t>(i) * CHUNK;
+      std::memcpy(out.data() + offset, chunk.data, std::min(CHUNK, out.size() - offset));
+    }
+    // Заголовок пишеться останнім: невідповідність CRC — обірваний запис
+    return snapshot_crc32(out.data(), out.size()) == this->header_.crc;
+  }
+
+  bool save(const uint8_t *data, size_t len) override {
+    if (len > N) {
+      ESP_LOGW("display_tools", "Snapshot too large: %u > %u bytes", (unsigned) len, (unsigned) N);
+      return false;
+    }
+    this->init_();
+    const uint32_t crc = snapshot_crc32(data, len);
+    if (this->read_header_() && this->header_.length == len && this->header_.crc == crc)
+      return true;  // той самий вміст уже збережено
+
+    // Поки слоти переписуються, збережений заголовок їм уже не відповідає
+    this->header_ = {};
+    Chunk chunk;
+    const uint16_t chunks = chunks_for_(len);
+    for (uint16_t i = 0; i < chunks; i++) {
+      const size_t offset = static_cast<size_t>(i) * CHUNK;
+      const size_t n = std::min(CHUNK, len - offset);
+      std::memcpy(chunk.data, data + offset, n);
+      std::memset(chunk.data + n, 0, CHUNK - n);
+      if (!this->chunk_(i).save(&chunk))
+        return false;
+    }
+    this->header_ = {static_cast<uint32_t>(len), crc, chunks};
+    this->header_valid_ = this->header_pref_.save(&this->header_);
+    return this->header_valid_;
+  }
+
+ protected:
+  struct Header {
+    uint32_t length;
+    uint32_t crc;
+    uint16_t chunks;
+  };
+  struct Chunk {
+    uint8_t data[CHUNK];
+  };
+
+  static uint16_t chunks_for_(size_t len) { return static_cast<uint16_t>((len + CHUNK - 1) / CHUNK); }
+
+  void init_() {
+    if (this->inited_)
+      return;
+    this->header_pref_ = global_preferences->make_preference<Header>(this->key_, true);
+    this->inited_ = true;
+  }
+  bool read_header_() {
+    if (!this->header_valid_)
+      this->header_valid_ = this->header_pref_.load(&this->header_);
+    return this->header_valid_;
+  }
+  // Слоти створюються при першому зверненні: малий блоб не резервує місце під N
+  ESPPreferenceObject &chunk_(uint16_t i) {
+    while (this->chunk_prefs_.size() <= i) {
+      const uint32_t key = this->key_ + 1 + static_cast<uint32_t>(this->chunk_prefs_.size());
+      this->chunk_prefs_.push_back(global_preferences->make_preference<Chunk>(key, true));
+    }
+    return this->chunk_prefs_[i];
+  }
+
+  uint32_t key_;
+  bool inited_{false};
+  bool header_valid_{false};
+  Header header_{};
+  ESPPreferenceObject header_pref_;
+  std::vector<ESPPreferenceObject> chunk_prefs_;
+};
+
+// Файл (host-платформа і тести): запис у .tmp і rename, щоб не лишити пів-файлу
+class FileSnapshotStore : public SnapshotStore {
+ public:
+  explicit FileSnapshotStore(std::string path) : path_(std::move(path)) {}
+
+  bool load(std::vector<uint8_t> &out) override {
+    FILE *f = std::fopen(this->path_.c_str(), "rb");
+    if (f == nullptr)
+      return false;
+    std::fseek(f, 0, SEEK_END);
+    long size = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    bool ok = size >= 0;
+    if (ok) {
+      out.resize(static_cast<size_t>(size));
+      ok = std::fread(out.data(), 1, out.size(), f) == out.size();
+    }
+    std::fclose(f);
+    return ok;
+  }
+
+  bool save(const uint8_t *data, size_t len) override {
+    std::string tmp = this->path_ + ".tmp";
+    FILE *f = std::fopen(tmp.c_str(), "wb");
+    if (f == nullptr)
+      return false;
+    bool ok = std::fwrite(data, 1, len, f) == len;
+    ok = (std::fclose(f) == 0) && ok;
+    return ok && std::rename(tmp.c_str(), this->path_.c_str()) == 0;
+  }
+
+ protected:
+  std::string path_;
+};
+
+}  // namespace display_tools
+}  // namespace esphome
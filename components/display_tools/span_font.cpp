@@ -0,0 +1,129 @@
+// span_font.cpp
+#include "span_font.h"
+
+#include <algorithm>
+
+namespace esphome {
+namespace display_tools {
+
+static const char *const TAG = "span_font";
+
+void SpanFont::clear() {
+  this->font_ = nullptr;
+  this->spans_.clear();
+  this->spans_.shrink_to_fit();
+  this->glyphs_.clear();
+  this->glyphs_.shrink_to_fit();
+}
+
+bool SpanFont::build(font::Font *font) {
+  this->clear();
+  if (font == nullptr || font->get_bpp() != 1)
+    return false;
+
+  const auto &glyphs = font->get_glyphs();
+  this->min_offset_x_ = 0;
+  this->glyphs_.reserve(glyphs.size());
+  for (const auto &glyph : glyphs) {
+    const font::GlyphData *gd = glyph.get_glyph_data();
+    if (gd->width > 255 || gd->height > 255) {
+      ESP_LOGW(TAG, "Glyph too large for spans (%dx%d), using generic print", gd->width, gd->height);
+      this->clear();
+      return false;
+    }
+    this->min_offset_x_ = std::min(this->min_offset_x_, gd->offset_x);
+    GlyphSpans g{static_cast<uint32_t>(this->spans_.size()), 0};
+    // Біти гліфа йдуть суцільним потоком, старший біт першим (як читає Font::print)
+    const uint8_t *data = gd->data;
+    uint8_t bitmask = 0, bits = 0;
+    for (int row = 0; row < gd->height; row++) {
+      int run_start = -1;
+      for (int col = 0; col <= gd->width; col++) {
+        bool on = false;
+        if (col < gd->width) {
+          if (bitmask == 0) {
+            bits = progmem_read_byte(data++);
+            bitmask = 0x80;
+          }
+          on = (bits & bitmask) != 0;
+          bitmask >>= 1;
+        }
+        if (on && run_start < 0) {
+          run_start = col;
+        } else if (!on && run_start >= 0) {
+          this->spans_.push_back(
+              {static_cast<uint8_t>(row), static_cast<uint8_t>(run_start), static_cast<uint8_t>(col - run_start)});
+          g.count++;
+          run_start = -1;
+        }
+      }
+    }
+    this->glyphs_.push_back(g);
+  }
+  this->spans_.shrink_to_fit();
+  this->font_ = font;
+  ESP_LOGD(TAG, "Prepared %u glyphs as %u spans (%u bytes)", (unsigned) this->glyphs_.size(),
+           (unsigned) this->spans_.size(),
+           (unsigned) (this->spans_.size() * sizeof(Span) + this->glyphs_.size() * sizeof(GlyphSpans)));
+  return true;
+}
+
+void HOT SpanFont::print(FrameProxy &it, int x, int y, Color color, display::TextAlign align, const char *text) {
+  if (this->font_ == nullptr || text == nullptr)
+    return;
+  // Вирівнювання як у Display::get_text_bounds; ширину міряємо лише для центру/правого краю
+  int x_at = x, y_start = y;
+  const int x_align = static_cast<int>(align) & 0x18;
+  const int y_align = static_cast<int>(align) & 0x07;
+  if (x_align != static_cast<int>(display::TextAlign::LEFT)) {
+    int width, x_offset, baseline, height;
+    this->font_->measure(text, &width, &x_offset, &baseline, &height);
+    x_at = x_align == static_cast<int>(display::TextAlign::RIGHT) ? x - width : x - width / 2;
+  }
+  if (y_align == static_cast<int>(display::TextAlign::BASELINE))
+    y_start = y - this->font_->get_baseline();
+  else if (y_align == static_cast<int>(display::TextAlign::BOTTOM))
+    y_start = y - this->font_->get_height();
+  else if (y_align == static_cast<int>(display::TextAlign::CENTER_VERTICAL))
+    y_start = y - this->font_->get_height() / 2;
+
+  // Видима смуга по x: гліфи поза нею лише зсувають курсор
+  int left = 0, right = it.get_width();
+  if (it.is_clipping()) {
+    const display::Rect clip = it.get_clipping();
+    left = std::max<int>(left, clip.x);
+    right = std::min<int>(right, clip.x2());
+  }
+
+  const auto &glyphs = this->font_->get_glyphs();
+  const uint8_t *str = reinterpret_cast<const uint8_t *>(text);
+  while (*str != '\0' && x_at + this->min_offset_x_ < right) {
+    int match_length;
+    const int n = this->font_->match_next_glyph(str, &match_length);
+    if (n < 0) {
+      // Невідомий символ: як у Font::print — прямокутник шириною першого гліфа
+      if (!glyphs.empty()) {
+        const int w = glyphs[0].get_glyph_data()->advance;
+        for (int row = 0; row < this->font_->get_height(); row++)
+          it.draw_span(x_at, y_start + row, w, color);
+        x_at += w;
+      }
+      str++;
+      continue;
+    }
+    const font::GlyphData *gd = glyphs[n].get_glyph_data();
+    const GlyphSpans &g = this->glyphs_[n];
+    const int gx = x_at + gd->offset_x;
+    if (gx + gd->width > left && gx < right) {
+      const int gy = y_start + gd->offset_y;
+      const Span *span = this->spans_.data() + g.first;
+      for (uint16_t i = 0; i < g.count; i++, span++)
+        it.draw_span(gx + span->x, gy + span->row, span->len, color);
+    }
+    x_at += gd->advance;
+    str += match_length;
+  }
+}
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,51 @@
+// span_font.h
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display/display.h"
+#include "esphome/components/font/font.h"
+#include "frame_proxy.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace display_tools {
+
+// ============================================================================
+// SpanFont: швидкий рендер 1bpp-шрифту. Під час set_app_font кожен гліф один раз
+// розкладається на горизонтальні відрізки (рядок, x, довжина); текст далі малюється
+// відрізками з кліпінгом на рівні відрізка, без розбору бітів на кожен піксель.
+// Вирівнювання і метрики — ті самі, що й у Display::print (get_text_bounds шрифту).
+// ============================================================================
+class SpanFont {
+ public:
+  // false, якщо шрифт не 1bpp (тоді лишається звичайний it.print)
+  bool build(font::Font *font);
+  void clear();
+  bool ready() const { return this->font_ != nullptr; }
+  const display::BaseFont *font() const { return this->font_; }
+  size_t span_count() const { return this->spans_.size(); }
+
+  // Аналог it.print(x, y, font, color, align, text) для FrameProxy
+  void print(FrameProxy &it, int x, int y, Color color, display::TextAlign align, const char *text);
+
+ protected:
+  struct Span {
+    uint8_t row;
+    uint8_t x;
+    uint8_t len;
+  };
+  struct GlyphSpans {
+    uint32_t first;
+    uint16_t count;
+  };
+
+  font::Font *font_{nullptr};
+  std::vector<Span> spans_;
+  std::vector<GlyphSpans> glyphs_;  // за індексом гліфа у шрифті
+  int min_offset_x_{0};             // найлівіший відступ гліфа: далі правого краю малювати вже нічого
+};
+
+}  // namespace display_tools
+}  // namespace esphome
@@ -0,0 +1,80 @@
+// animation_timebase.h — драйвер animation_timebase.yaml
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display_tools/display_tools.h"
+#include "host_framebuffer.h"
+
+#include <memory>
+#include <vector>
+
+namespace animation_timebase {
+
+using esphome::display_tools::BitmapAnimation;
+using esphome::display_tools::DisplayTools;
+using esphome::display_tools::DrawCommandType;
+using esphome::display_tools::DrawObject;
+using host_test::HostFramebuffer;
+
+static const char *const TAG = "animation_timebase";
+static const uint32_t STEP_MS = 8;  // replay_frame_step з animation_timebase.yaml
+static const uint16_t FRAME_MS = 1000;  // три кадри: цикл 3 с, довший за паузу на один повтор (2 с)
+static const uint16_t APP_DURATION = 3;  // показ app — 3 повтори по 2 с
+static const int SIZE = 4;
+
+static std::vector<uint8_t> solid(uint8_t v) { return std::vector<uint8_t>(SIZE * SIZE * 3, v); }
+
+}  // namespace animation_timebase
+
+// Кадри ANIMATION рахуються від початку показу app, а не від кожного повтору паузи:
+// за 6 с показу анімація з циклом 3 с проходить кадри 0, 1, 2, 0, 1, 2.
+// true — кожен кадр панелі збігся з очікуваним кадром анімації
+static bool run_animation_timebase(esphome::display_tools::DisplayTools *tools) {
+  using namespace animation_timebase;
+  HostFramebuffer fb(128, 64);
+
+  DrawObject anim;
+  anim.type = DrawCommandType::ANIMATION;
+  anim.x1 = 0, anim.y1 = 0, anim.x2 = SIZE, anim.y2 = SIZE;
+  anim.bitmap_data = solid(0x20);
+  anim.animation = std::make_shared<BitmapAnimation>();
+  anim.animation->add_frame(FRAME_MS);
+  for (uint8_t v : {0x80, 0xF0}) {
+    anim.animation->add_frame(FRAME_MS);
+    const std::vector<uint8_t> rect = solid(v);
+    anim.animation->add_rect(0, 0, SIZE, SIZE, rect.data(), rect.size());
+  }
+  tools->addApp("anim", "-", "FFFFFF", APP_DURATION, "", "FFFFFF", {}, {anim});
+  while (tools->getCurrentApp() == nullptr || tools->getCurrentApp()->name != "anim")
+    tools->nextApp();
+
+  // CRC смуги з анімацією на кожному кадрі показу
+  const uint32_t show_ms = APP_DURATION * 2000;
+  std::vector<uint32_t> crcs;
+  for (uint32_t t = 0; t < show_ms; t += STEP_MS) {
+    fb.clear_pixels();
+    tools->render_screen(fb);
+    crcs.push_back(fb.crc(0, SIZE));
+  }
+
+  const uint32_t expected[3] = {crcs[(FRAME_MS / 2) / STEP_MS], crcs[(FRAME_MS * 3 / 2) / STEP_MS],
+                                crcs[(FRAME_MS * 5 / 2) / STEP_MS]};
+  bool ok = expected[0] != expected[1] && expected[1] != expected[2] && expected[0] != expected[2];
+  if (!ok)
+    ESP_LOGE(TAG, "FAIL: animation frames are not distinct");
+  int mismatches = 0;
+  for (size_t i = 0; i < crcs.size(); i++) {
+    const uint32_t t = static_cast<uint32_t>(i) * STEP_MS;
+    if (crcs[i] != expected[(t / FRAME_MS) % 3]) {
+      if (mismatches++ == 0)
+        ESP_LOGE(TAG, "FAIL: frame at %u ms shows the wrong animation frame", (unsigned) t);
+    }
+  }
+  ok &= mismatches == 0;
+  ok &= tools->getCurrentApp() != nullptr && tools->getCurrentApp()->name == "anim";
+  tools->delApp("anim");
+
+  ESP_LOGI(TAG, "%s: %u frames over %u ms, %d mismatched", ok ? "PASS" : "FAIL", (unsigned) crcs.size(),
+           (unsigned) show_ms, mismatches);
+  return ok;
+}
@@ -0,0 +1,238 @@
+// dfplayer_bench.h — драйвер dfplayer_bench.yaml
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/dfplayer_pro/dfplayer_pro.h"
+#include "esphome/components/dfplayer_pro/dfplayer_emulator.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <vector>
+
+namespace dfplayer_bench {
+
+using esphome::dfplayer_pro::CommandCallback;
+using esphome::dfplayer_pro::DFPlayerEmulator;
+using esphome::dfplayer_pro::DFPlayerPro;
+using esphome::dfplayer_pro::Query;
+using esphome::dfplayer_pro::QueryResult;
+using esphome::dfplayer_pro::ResultCallback;
+
+static const char *const TAG = "dfplayer_bench";
+
+// Плеєр і емулятор на спільному часі симуляції; loop() викликається раз на змодельовану мілісекунду
+class Bench {
+ public:
+  // Одна команда з колбеком: від постановки до OK/ERROR/таймауту
+  struct Probe {
+    Bench *bench;
+    uint32_t queued_ms;
+    bool done{false};
+    bool ok{false};
+    char text[esphome::dfplayer_pro::Command::ARG_LENGTH]{};
+  };
+
+  Bench(DFPlayerPro *player, DFPlayerEmulator *emu) : player_(player), emu_(emu) {
+    this->player_->set_time_source([this]() { return this->now_ms_; });
+    this->emu_->set_time_source([this]() { return this->now_ms_; });
+  }
+  ~Bench() {
+    this->player_->set_time_source(nullptr);
+    this->emu_->set_time_source(nullptr);
+  }
+
+  uint32_t now() const { return this->now_ms_; }
+  DFPlayerPro *player() { return this->player_; }
+  DFPlayerEmulator *emu() { return this->emu_; }
+
+  void run(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++)
+      this->tick_();
+  }
+  // Крутить loop(), доки probe не завершиться (або не вийде limit_ms)
+  bool wait(const Probe &probe, uint32_t limit_ms) {
+    for (uint32_t i = 0; i < limit_ms && !probe.done; i++)
+      this->tick_();
+    return probe.done;
+  }
+
+  Probe &play(int no) {
+    Probe &p = this->new_probe_();
+    if (!this->player_->play_file_no(no, CommandCallback{&Bench::on_command_, &p}))
+      p.done = true;
+    return p;
+  }
+  Probe &query(Query q) {
+    Probe &p = this->new_probe_();
+    if (!this->player_->query(q, ResultCallback{&Bench::on_result_, &p}))
+      p.done = true;
+    return p;
+  }
+
+  std::vector<uint32_t> &latencies() { return this->latencies_; }
+  uint64_t loop_ns() const { return this->loop_ns_; }
+  uint32_t completed() const { return this->completed_; }
+  void reset_counters() {
+    this->latencies_.clear();
+    this->loop_ns_ = 0;
+    this->completed_ = 0;
+  }
+
+ protected:
+  static void on_command_(void *ctx, bool ok) {
+    auto *p = static_cast<Probe *>(ctx);
+    p->bench->finish_(*p, ok);
+  }
+  static void on_result_(void *ctx, bool ok, const QueryResult &result) {
+    auto *p = static_cast<Probe *>(ctx);
+    if (ok && result.text != nullptr)
+      snprintf(p->text, sizeof(p->text), "%s", result.text);
+    p->bench->finish_(*p, ok);
+  }
+
+  void finish_(Probe &p, bool ok) {
+    p.done = true;
+    p.ok = ok;
+    this->latencies_.push_back(this->now_ms_ - p.queued_ms);
+    this->completed_++;
+  }
+  Probe &new_probe_() {
+    // deque: адреси вже виданих probe не змінюються, поки на них чекають колбеки
+    this->probes_.push_back(Probe{this, this->now_ms_});
+    if (this->probes_.size() > 4096 && this->probes_.front().done)
+      this->probes_.pop_front();
+    return this->probes_.back();
+  }
+  void tick_() {
+    const auto t0 = std::chrono::steady_clock::now();
+    this->player_->loop();
+    const auto t1 = std::chrono::steady_clock::now();
+    this->loop_ns_ += std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    this->now_ms_++;
+  }
+
+  DFPlayerPro *player_;
+  DFPlayerEmulator *emu_;
+  uint32_t now_ms_{1};
+  std::deque<Probe> probes_;
+  std::vector<uint32_t> latencies_;
+  uint64_t loop_ns_{0};
+  uint32_t completed_{0};
+};
+
+static uint32_t percentile(std::vector<uint32_t> values, uint8_t pct) {
+  if (values.empty())
+    return 0;
+  const size_t k = std::min(values.size() - 1, values.size() * pct / 100);
+  std::nth_element(values.begin(), values.begin() + k, values.end());
+  return values[k];
+}
+
+static bool check(bool cond, const char *what) {
+  if (!cond)
+    ESP_LOGE(TAG, "FAIL: %s", what);
+  return cond;
+}
+
+// Черга тримається заповненою сумішшю відтворення, налаштувань і запитів стану
+static bool bench_throughput(Bench &b, uint32_t duration_ms) {
+  static const Query QUERIES[] = {Query::CURRENT_TIME, Query::VOLUME, Query::FILE_NAME, Query::TOTAL_TIME};
+  b.reset_counters();
+  const uint32_t start = b.now();
+  uint32_t n = 0;
+  while (b.now() - start < duration_ms) {
+    while (b.player()->get_queue_depth() < 8) {
+      switch (n++ % 4) {
+        case 0:
+          b.play(1 + n % 10);
+          break;
+        case 1:
+          b.player()->set_volume(static_cast<int>(n % 31));
+          break;
+        default:
+          b.query(QUERIES[n % 4]);
+          break;
+      }
+    }
+    b.run(1);
+  }
+  const double seconds = duration_ms / 1000.0;
+  const auto &lat = b.latencies();
+  ESP_LOGI(TAG, "throughput: %u play/query completions in %.0f s simulated = %.1f/s; latency p50=%u p99=%u max=%u ms",
+           (unsigned) b.completed(), seconds, b.completed() / seconds, (unsigned) percentile(lat, 50),
+           (unsigned) percentile(lat, 99), lat.empty() ? 0u : (unsigned) *std::max_element(lat.begin(), lat.end()));
+  ESP_LOGI(TAG, "host cost: %.2f us of loop() per completion",
+           b.completed() ? b.loop_ns() / 1000.0 / b.completed() : 0.0);
+  return check(b.completed() > 0 && b.player()->get_timeout_count() == 0, "throughput without timeouts");
+}
+
+// Модуль замовк: відповіді губляться повністю. Команди мають закритися таймаутом, запити — повторитись,
+// після трьох таймаутів поспіль плеєр переходить у degraded і перезапускає init; потім модуль оживає
+static bool bench_timeouts(Bench &b) {
+  bool ok = true;
+  const uint32_t timeouts_before = b.player()->get_timeout_count();
+  b.emu()->set_drop_rate(1.0f);
+  Bench::Probe &play = b.play(3);
+  Bench::Probe &volume = b.query(Query::VOLUME);
+  ok &= check(b.wait(play, 5000) && !play.ok, "play times out");
+  ok &= check(b.wait(volume, 5000) && !volume.ok, "query times out after retries");
+  b.run(2000);
+  const uint32_t timeouts = b.player()->get_timeout_count() - timeouts_before;
+  ok &= check(timeouts >= 3, "timeouts counted");
+  ok &= check(b.player()->is_degraded(), "player degraded");
+  ESP_LOGI(TAG, "timeout path: %u timeouts, timeout now %u ms, degraded=%s", (unsigned) timeouts,
+           (unsigned) b.player()->get_timeout(esphome::dfplayer_pro::Opcode::QUERY),
+           b.player()->is_degraded() ? "yes" : "no");
+
+  b.emu()->set_drop_rate(0.0f);
+  const uint32_t start = b.now();
+  while (b.player()->is_degraded() && b.now() - start < 30000)
+    b.run(10);
+  ok &= check(!b.player()->is_degraded(), "player recovers");
+  Bench::Probe &after = b.query(Query::VOLUME);
+  ok &= check(b.wait(after, 2000) && after.ok, "query after recovery");
+  ESP_LOGI(TAG, "recovered after %u ms", (unsigned) (b.now() - start));
+  return ok;
+}
+
+// Без опитування (poll_interval 0) стан відтворення тримається на тривалості треку з TOTAL_TIME
+static bool check_playing_state(Bench &b, uint32_t track_ms) {
+  bool ok = true;
+  Bench::Probe &play = b.play(2);
+  ok &= check(b.wait(play, 2000) && play.ok && b.player()->is_playing(), "playing after OK");
+  b.run(track_ms / 2);
+  ok &= check(b.player()->is_playing(), "still playing mid-track");
+  b.run(track_ms + 1000);
+  ok &= check(!b.player()->is_playing() && !b.emu()->is_playing(), "stopped after track length");
+  return ok;
+}
+
+}  // namespace dfplayer_bench
+
+// DFPlayerPro проти DFPlayerEmulator без заліза і реального часу: пропускна здатність і хвіст затримки
+// черги, відповідь на запит імені без відтвореного файлу, стан відтворення без опитування,
+// шлях таймаутів і відновлення.
+// true — усі перевірки пройшли
+static bool run_dfplayer_bench(esphome::dfplayer_pro::DFPlayerPro *player,
+                               esphome::dfplayer_pro::DFPlayerEmulator *emu) {
+  using namespace dfplayer_bench;
+  Bench b(player, emu);
+  bool ok = true;
+
+  player->init();
+  // До першого відтворення модуль відповідає на ім'я файлу явним значенням, а не порожнім рядком
+  Bench::Probe &name = b.query(Query::FILE_NAME);
+  ok &= check(b.wait(name, 2000) && name.ok && strcmp(name.text, "NONE") == 0, "file name before playback");
+
+  ok &= check_playing_state(b, 3000);
+  ok &= bench_throughput(b, 60000);
+  ok &= bench_timeouts(b);
+
+  std::string stats;
+  player->get_stats_json(stats);
+  ESP_LOGI(TAG, "stats: %s", stats.c_str());
+  ESP_LOGI(TAG, "%s", ok ? "PASS" : "FAIL");
+  return ok;
+}
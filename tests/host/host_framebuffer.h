@@ -0,0 +1,53 @@
+// host_framebuffer.h — дисплей у пам'яті для хост-драйверів (tests/host)
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display/display.h"
+#include "esphome/components/display_tools/frame_proxy.h"
+#include "esphome/components/display_tools/snapshot.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace host_test {
+
+// ============================================================================
+// HostFramebuffer: панель без заліза. Пікселі лягають у RGB565-буфер, як на HUB75,
+// тож кадр можна порівняти за CRC32 (усього або смуги рядків).
+// ============================================================================
+class HostFramebuffer : public esphome::display::Display {
+ public:
+  HostFramebuffer(int width, int height)
+      : width_(width), height_(height), pixels_(static_cast<size_t>(width * height)) {}
+
+  void clear_pixels() { std::fill(this->pixels_.begin(), this->pixels_.end(), 0); }
+  // CRC32 рядків [y0, y1)
+  uint32_t crc(int y0, int y1) const {
+    y0 = std::max(0, y0);
+    y1 = std::min(this->height_, y1);
+    if (y1 <= y0)
+      return 0;
+    return esphome::display_tools::snapshot_crc32(
+        reinterpret_cast<const uint8_t *>(this->pixels_.data() + y0 * this->width_),
+        static_cast<size_t>((y1 - y0) * this->width_) * sizeof(uint16_t));
+  }
+  uint32_t crc() const { return this->crc(0, this->height_); }
+
+  void draw_pixel_at(int x, int y, esphome::Color color) override {
+    if (x < 0 || y < 0 || x >= this->width_ || y >= this->height_)
+      return;
+    this->pixels_[y * this->width_ + x] = esphome::display_tools::FrameProxy::to_565(color);
+  }
+  esphome::display::DisplayType get_display_type() override { return esphome::display::DISPLAY_TYPE_COLOR; }
+  void update() override {}
+
+ protected:
+  int get_width_internal() override { return this->width_; }
+  int get_height_internal() override { return this->height_; }
+
+  int width_;
+  int height_;
+  std::vector<uint16_t> pixels_;
+};
+
+}  // namespace host_test
@@ -0,0 +1,313 @@
+// payload_churn.h — драйвер payload_churn.yaml
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display_tools/display_tools.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace payload_churn {
+
+using esphome::display_tools::ArenaBacking;
+using esphome::display_tools::DisplayTools;
+using esphome::display_tools::DrawCommandType;
+using esphome::display_tools::DrawObject;
+using esphome::display_tools::PayloadString;
+
+static const char *const TAG = "payload_churn";
+static const size_t HEAP_SIZE = 48 * 1024;
+static const int APPS = 12;
+static const int OPS = 4000;
+
+// Модель купи: first-fit по вільних проміжках зі злиттям сусідніх, гранула max_align_t
+class SimHeap : public ArenaBacking {
+ public:
+  static const size_t npos = static_cast<size_t>(-1);
+  static constexpr size_t GRAIN = alignof(std::max_align_t);
+
+  SimHeap() : mem_(new std::max_align_t[HEAP_SIZE / sizeof(std::max_align_t)]) { this->free_[0] = HEAP_SIZE; }
+
+  uint8_t *allocate(size_t size) override {
+    const size_t off = this->take(size);
+    return off == npos ? nullptr : this->base_() + off;
+  }
+  void release(uint8_t *ptr, size_t size) override { this->give(static_cast<size_t>(ptr - this->base_()), size); }
+
+  // Зсув блоку від початку купи; npos — немає проміжку потрібного розміру
+  size_t take(size_t size) {
+    size = round_(size);
+    for (auto it = this->free_.begin(); it != this->free_.end(); ++it) {
+      if (it->second < size)
+        continue;
+      const size_t off = it->first, rest = it->second - size;
+      this->free_.erase(it);
+      if (rest > 0)
+        this->free_[off + size] = rest;
+      this->live_++;
+      return off;
+    }
+    this->failed_++;
+    return npos;
+  }
+  void give(size_t off, size_t size) {
+    size = round_(size);
+    auto next = this->free_.lower_bound(off);
+    if (next != this->free_.end() && next->first == off + size) {
+      size += next->second;
+      next = this->free_.erase(next);
+    }
+    if (next != this->free_.begin()) {
+      auto prev = std::prev(next);
+      if (prev->first + prev->second == off) {
+        prev->second += size;
+        this->live_--;
+        return;
+      }
+    }
+    this->free_[off] = size;
+    this->live_--;
+  }
+
+  size_t free_bytes() const {
+    size_t n = 0;
+    for (const auto &gap : this->free_)
+      n += gap.second;
+    return n;
+  }
+  size_t largest_free_block() const {
+    size_t n = 0;
+    for (const auto &gap : this->free_)
+      n = std::max(n, gap.second);
+    return n;
+  }
+  size_t live_blocks() const { return this->live_; }
+  size_t failed() const { return this->failed_; }
+
+ protected:
+  static size_t round_(size_t size) { return (std::max<size_t>(size, 1) + GRAIN - 1) & ~(GRAIN - 1); }
+  uint8_t *base_() { return reinterpret_cast<uint8_t *>(this->mem_.get()); }
+
+  std::unique_ptr<std::max_align_t[]> mem_;
+  std::map<size_t, size_t> free_;  // зсув → розмір вільного проміжку
+  size_t live_{0};
+  size_t failed_{0};
+};
+
+// Одна операція над app: оновлення (або додавання) одним із трьох видів вмісту, або видалення.
+// Купу ділять і інші: поки app оновлюється, живе буфер повідомлення MQTT, а зрідка хтось бере
+// блок надовго (і не віддає до кінця churn)
+struct Op {
+  int app;
+  bool del;
+  std::string body;
+  std::vector<std::pair<std::string, std::string>> parts;    // текст, id
+  std::vector<std::pair<std::string, std::string>> objects;  // текст TEXT, id
+  size_t message;  // буфер повідомлення на час оновлення
+  size_t pinned;   // 0 — нічого не бере надовго
+};
+
+static std::string random_text(std::mt19937 &rng, int max_len) {
+  std::string s(std::uniform_int_distribution<int>(1, max_len)(rng), 'a');
+  for (auto &c : s)
+    c = static_cast<char>('a' + rng() % 26);
+  return s;
+}
+
+// Спершу всі apps по разу, далі випадкові оновлення і зрідка видалення
+static std::vector<Op> make_ops() {
+  std::mt19937 rng(47);
+  std::vector<Op> ops;
+  for (int i = 0; i < APPS + OPS; i++) {
+    Op op{i < APPS ? i : static_cast<int>(rng() % APPS), i >= APPS && rng() % 8 == 0, {}, {}, {}, 64, 0};
+    if (!op.del) {
+      switch (rng() % 3) {
+        case 0:
+          op.body = random_text(rng, 64);
+          break;
+        case 1:
+          for (int k = 1 + rng() % 5; k > 0; k--)
+            op.parts.emplace_back(random_text(rng, 24), rng() % 2 ? "p" + std::to_string(k) : "");
+          break;
+        default:
+          op.body = "-";
+          for (int k = 1 + rng() % 8; k > 0; k--)
+            op.objects.emplace_back(random_text(rng, 32), rng() % 2 ? "value_" + std::to_string(k) : "");
+          break;
+      }
+    }
+    op.message += op.body.size();
+    for (const auto &part : op.parts)
+      op.message += 24 + part.first.size() + part.second.size();
+    for (const auto &obj : op.objects)
+      op.message += 48 + obj.first.size() + obj.second.size();
+    if (rng() % 40 == 0)
+      op.pinned = 32 + rng() % 128;
+    ops.push_back(std::move(op));
+  }
+  return ops;
+}
+
+static std::string app_name(int app) { return "app" + std::to_string(app); }
+
+// ---- Старе розміщення: кожен рядок і вектор вантажу — окремий блок купи ----
+// Ті самі структури, але з std::string, де алокатор порожній
+static const size_t HEAP_STRING_LOCAL = std::string().capacity();
+static const size_t ALLOCATOR_SIZE = sizeof(PayloadString) - sizeof(std::string);
+static const size_t HEAP_WORD_SIZE = sizeof(DisplayTools::ColoredWord) - 2 * ALLOCATOR_SIZE;
+static const size_t HEAP_OBJECT_SIZE = sizeof(DrawObject) - 2 * ALLOCATOR_SIZE;
+
+class PieceModel {
+ public:
+  explicit PieceModel(SimHeap &heap) : heap_(heap) {}
+
+  void apply(const Op &op) {
+    std::vector<std::pair<size_t, size_t>> pieces;
+    if (!op.del) {
+      // вектори з рядками будує той, хто викликає addApp, а тіло копіюється вже в app
+      if (!op.parts.empty())
+        this->take_(pieces, op.parts.size() * HEAP_WORD_SIZE);
+      for (const auto &part : op.parts)
+        this->take_string_(pieces, part.first), this->take_string_(pieces, part.second);
+      if (!op.objects.empty())
+        this->take_(pieces, op.objects.size() * HEAP_OBJECT_SIZE);
+      for (const auto &obj : op.objects)
+        this->take_string_(pieces, obj.first), this->take_string_(pieces, obj.second);
+      this->take_string_(pieces, op.body);
+    }
+    for (const auto &piece : this->apps_[op.app])
+      this->heap_.give(piece.first, piece.second);
+    this->apps_[op.app] = std::move(pieces);
+  }
+  void clear() {
+    for (auto &app : this->apps_) {
+      for (const auto &piece : app.second)
+        this->heap_.give(piece.first, piece.second);
+    }
+    this->apps_.clear();
+  }
+
+ protected:
+  void take_(std::vector<std::pair<size_t, size_t>> &pieces, size_t size) {
+    const size_t off = this->heap_.take(size);
+    if (off != SimHeap::npos)
+      pieces.emplace_back(off, size);
+  }
+  void take_string_(std::vector<std::pair<size_t, size_t>> &pieces, const std::string &s) {
+    if (s.size() > HEAP_STRING_LOCAL)
+      this->take_(pieces, s.size() + 1);
+  }
+
+  SimHeap &heap_;
+  std::map<int, std::vector<std::pair<size_t, size_t>>> apps_;
+};
+
+static void apply_to_tools(DisplayTools *tools, const Op &op) {
+  const std::string name = app_name(op.app);
+  if (op.del) {
+    tools->delApp(name);
+    return;
+  }
+  std::vector<DisplayTools::ColoredWord> parts;
+  for (const auto &part : op.parts)
+    parts.push_back({PayloadString(part.first.c_str()), esphome::Color::WHITE, nullptr,
+                     PayloadString(part.second.c_str()), -1, 0});
+  std::vector<DrawObject> objects;
+  for (const auto &obj : op.objects) {
+    DrawObject text;
+    text.type = DrawCommandType::TEXT;
+    text.text = obj.first;
+    text.id = obj.second;
+    objects.push_back(std::move(text));
+  }
+  tools->addApp(name, op.body, "FFFFFF", 2, "", "FFFFFF", std::move(parts), std::move(objects));
+}
+
+// Операція разом із рештою трафіку купи; apply — сама зміна app
+template<typename F> static void run_op(SimHeap &heap, const Op &op, std::vector<size_t> &pinned, F apply) {
+  const size_t message = heap.take(op.message);
+  apply(op);
+  heap.give(message, op.message);
+  if (op.pinned != 0)
+    pinned.push_back(heap.take(op.pinned));
+}
+
+static void release_pinned(SimHeap &heap, const std::vector<Op> &ops, const std::vector<size_t> &pinned) {
+  size_t i = 0;
+  for (const auto &op : ops) {
+    if (op.pinned != 0)
+      heap.give(pinned[i++], op.pinned);
+  }
+}
+
+static void log_heap(const char *layout, const char *when, const SimHeap &heap) {
+  ESP_LOGI(TAG, "%-7s %-14s free=%5u largest free block=%5u live blocks=%3u", layout, when,
+           (unsigned) heap.free_bytes(), (unsigned) heap.largest_free_block(), (unsigned) heap.live_blocks());
+}
+
+}  // namespace payload_churn
+
+// Оновлення і видалення apps на змодельованій купі: арена вантажу app (один блок на app, що
+// звільняється цілим) проти старого розміщення, де кожен рядок і вектор — окремий блок.
+// Друкує вільне місце і найбільший вільний блок до і після. true — арени повернули купу цілою
+static bool run_payload_churn(esphome::display_tools::DisplayTools *tools) {
+  using namespace payload_churn;
+  const std::vector<Op> ops = make_ops();
+  bool ok = true;
+
+  // Купа живе до кінця процесу: tools лишається з нею як backing
+  static SimHeap arena_heap;
+  tools->set_payload_backing(&arena_heap);
+  std::set<int> live;
+  std::vector<size_t> pinned;
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (i == APPS)
+      log_heap("arena", "before churn", arena_heap);
+    run_op(arena_heap, ops[i], pinned, [tools](const Op &op) { apply_to_tools(tools, op); });
+    if (ops[i].del)
+      live.erase(ops[i].app);
+    else
+      live.insert(ops[i].app);
+  }
+  log_heap("arena", "after churn", arena_heap);
+  // вантаж кожного app — рівно один блок: розмір арени порахований наперед
+  if (arena_heap.live_blocks() != live.size() + pinned.size()) {
+    ESP_LOGE(TAG, "FAIL: %u arena blocks for %u apps", (unsigned) (arena_heap.live_blocks() - pinned.size()),
+             (unsigned) live.size());
+    ok = false;
+  }
+  release_pinned(arena_heap, ops, pinned);
+  for (int app = 0; app < APPS; app++)
+    tools->delApp(app_name(app));
+  log_heap("arena", "all deleted", arena_heap);
+  if (arena_heap.live_blocks() != 0 || arena_heap.largest_free_block() != HEAP_SIZE) {
+    ESP_LOGE(TAG, "FAIL: arenas did not return the heap whole");
+    ok = false;
+  }
+
+  SimHeap piece_heap;
+  PieceModel pieces(piece_heap);
+  pinned.clear();
+  for (size_t i = 0; i < ops.size(); i++) {
+    if (i == APPS)
+      log_heap("pieces", "before churn", piece_heap);
+    run_op(piece_heap, ops[i], pinned, [&pieces](const Op &op) { pieces.apply(op); });
+  }
+  log_heap("pieces", "after churn", piece_heap);
+  release_pinned(piece_heap, ops, pinned);
+  pieces.clear();
+  log_heap("pieces", "all deleted", piece_heap);
+
+  if (arena_heap.failed() != 0 || piece_heap.failed() != 0) {
+    ESP_LOGE(TAG, "FAIL: simulated heap ran out (%u arena, %u pieces)", (unsigned) arena_heap.failed(),
+             (unsigned) piece_heap.failed());
+    ok = false;
+  }
+  ESP_LOGI(TAG, "%s: %u operations on %u apps", ok ? "PASS" : "FAIL", (unsigned) ops.size(), (unsigned) APPS);
+  return ok;
+}
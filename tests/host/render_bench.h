@@ -0,0 +1,167 @@
+// render_bench.h — драйвер render_bench.yaml
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display_tools/display_tools.h"
+#include "host_framebuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace render_bench {
+
+using esphome::Color;
+using esphome::display_tools::ColorStage;
+using esphome::display_tools::DisplayTools;
+using esphome::display_tools::FrameProxy;
+using host_test::HostFramebuffer;
+
+static const char *const TAG = "render_bench";
+static const int WIDTH = 128;
+static const int HEIGHT = 64;
+
+// Час render_screen по кадрах, згрупований за app, що був поточним на початку кадру
+class FrameTimer {
+ public:
+  void add(const std::string &name, uint32_t ns) { this->samples_[name].push_back(ns); }
+  void clear() { this->samples_.clear(); }
+  // p50 у нс для app; 0 — кадрів не було
+  uint32_t p50(const std::string &name) const { return this->percentile_(name, 50); }
+
+  void report(const char *scenario) const {
+    for (const auto &kv : this->samples_) {
+      double sum = 0;
+      for (uint32_t v : kv.second)
+        sum += v;
+      ESP_LOGI(TAG, "%-14s %-10s frames=%-6u mean=%7.1f us  p50=%7.1f us  p99=%7.1f us", scenario, kv.first.c_str(),
+               (unsigned) kv.second.size(), sum / kv.second.size() / 1000.0,
+               this->percentile_(kv.first, 50) / 1000.0, this->percentile_(kv.first, 99) / 1000.0);
+    }
+  }
+
+ protected:
+  uint32_t percentile_(const std::string &name, uint8_t pct) const {
+    auto it = this->samples_.find(name);
+    if (it == this->samples_.end() || it->second.empty())
+      return 0;
+    std::vector<uint32_t> sorted = it->second;
+    const size_t k = std::min(sorted.size() - 1, sorted.size() * pct / 100);
+    std::nth_element(sorted.begin(), sorted.begin() + k, sorted.end());
+    return sorted[k];
+  }
+
+  std::map<std::string, std::vector<uint32_t>> samples_;
+};
+
+template<typename F> static uint32_t elapsed_ns(F &&body) {
+  const auto t0 = std::chrono::steady_clock::now();
+  body();
+  const auto t1 = std::chrono::steady_clock::now();
+  return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+}
+
+// Дата (user-032) до і після кешу часу проти голої бітмапи тієї самої смуги 128x28.
+//  - blit: RGB-байти піксель за пікселем через FrameProxy, як draw_bitmap_from_vector,
+//    без очищення екрана і копії команд, які платить app з draw_objects;
+//  - після кешу: render_app_screen з __date__ і теплим кешем;
+//  - до кешу: те саме плюс перерахунок кешу на кожному кадрі (localtime, strftime, місяць
+//    у верхньому регістрі і його ширина) — стільки старий код робив щокадру. Ціна перерахунку —
+//    різниця render_screen після зсуву replay_epoch на добу і без нього.
+static void bench_date_vs_blit(DisplayTools *tools, HostFramebuffer &fb, int frames) {
+  static const int BAND_TOP = 36, BAND_HEIGHT = 28;
+  static const time_t EPOCH = 1760000000;  // replay_epoch з render_bench.yaml
+  static const time_t DAY = 24 * 60 * 60;
+  std::vector<uint8_t> band(static_cast<size_t>(WIDTH * BAND_HEIGHT * 3));
+  for (size_t i = 0; i < band.size(); i++)
+    band[i] = static_cast<uint8_t>(i * 31);
+
+  ColorStage stage;
+  FrameProxy proxy;
+  proxy.set_target(&fb);
+  proxy.set_color_stage(&stage);
+
+  FrameTimer timer;
+  tools->set_replay_epoch(EPOCH);
+  fb.clear_pixels();
+  tools->render_screen(fb);  // прогріває кеш
+  for (int i = 0; i < frames; i++) {
+    fb.clear_pixels();
+    timer.add("blit", elapsed_ns([&] {
+                for (int y = 0; y < BAND_HEIGHT; y++) {
+                  for (int x = 0; x < WIDTH; x++) {
+                    const uint8_t *px = &band[static_cast<size_t>((y * WIDTH + x) * 3)];
+                    proxy.draw_pixel_at(x, BAND_TOP + y, Color(px[0], px[1], px[2]));
+                  }
+                }
+              }));
+    fb.clear_pixels();
+    timer.add("__date__", elapsed_ns([&] { tools->render_app_screen(proxy); }));
+    fb.clear_pixels();
+    timer.add("frame", elapsed_ns([&] { tools->render_screen(fb); }));
+    // Наступна доба: кадр перераховує весь кеш, а наступна ітерація вже малює з теплого
+    tools->set_replay_epoch(EPOCH + (i + 1) * DAY);
+    fb.clear_pixels();
+    timer.add("frame+cache", elapsed_ns([&] { tools->render_screen(fb); }));
+  }
+  tools->set_replay_epoch(EPOCH);
+
+  timer.report("date_vs_blit");
+  const double blit = timer.p50("blit") / 1000.0, after = timer.p50("__date__") / 1000.0;
+  const double refresh = std::max(0.0, (static_cast<double>(timer.p50("frame+cache")) - timer.p50("frame")) / 1000.0);
+  ESP_LOGI(TAG, "date_vs_blit   blit p50=%.1f us; __date__ p50 before cache=%.1f us, after=%.1f us (%.2fx blit)", blit,
+           after + refresh, after, blit > 0 ? after / blit : 0.0);
+}
+
+// Скрол алерту шрифтом app (user-045): відрізки SpanFont проти it.print на тих самих кадрах.
+// Смуга app порівнюється по CRC кадр за кадром; false — хоч один кадр відрізняється
+static bool bench_spans_vs_print(DisplayTools *tools, HostFramebuffer &fb, esphome::font::Font *font, int frames) {
+  static const char *const TEXT = "Увага! Повітряна тривога в Київській області. Прямуйте до найближчого укриття.";
+  static const int BAND_TOP = 32;
+  static const char *const PASSES[] = {"spans", "it.print"};
+  FrameTimer timer;
+  std::vector<uint32_t> crcs[2];
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 0)
+      tools->set_app_font(font);
+    else
+      tools->set_app_font(static_cast<esphome::display::BaseFont *>(font));
+    // Один кадр іншого алерту скидає стан скролу: обидва проходи стартують з правого краю
+    tools->addAlert("-", "FFFFFF", "", "FF0000", "7", 1);
+    fb.clear_pixels();
+    tools->render_screen(fb);
+    tools->removeCurrentAlert();
+
+    tools->addAlert(TEXT, "FFFF00", "", "FF0000", "7", 100);
+    for (int i = 0; i < frames; i++) {
+      fb.clear_pixels();
+      timer.add(PASSES[pass], elapsed_ns([&] { tools->render_screen(fb); }));
+      crcs[pass].push_back(fb.crc(BAND_TOP, HEIGHT));
+    }
+    tools->removeCurrentAlert();
+  }
+  tools->set_app_font(font);
+
+  int mismatches = 0;
+  for (int i = 0; i < frames; i++)
+    mismatches += crcs[0][i] != crcs[1][i];
+  timer.report("spans_vs_print");
+  const uint32_t spans = timer.p50("spans"), print = timer.p50("it.print");
+  ESP_LOGI(TAG, "spans_vs_print it.print p50 = %.2fx spans p50, %d of %d frames differ", spans > 0
+           ? static_cast<double>(print) / spans : 0.0, mismatches, frames);
+  return mismatches == 0;
+}
+
+}  // namespace render_bench
+
+// Бенчмарки рендеру на хості: годинник анімацій і настінний час зафіксовані в YAML
+// (replay_frame_step, replay_epoch), тож кожен запуск малює ті самі кадри.
+// app_font — 1bpp-шрифт app; false — швидкий шлях SpanFont розійшовся з it.print
+static bool run_render_bench(esphome::display_tools::DisplayTools *tools, esphome::font::Font *app_font, int frames) {
+  using namespace render_bench;
+  HostFramebuffer fb(WIDTH, HEIGHT);
+  bench_date_vs_blit(tools, fb, frames);
+  return bench_spans_vs_print(tools, fb, app_font, frames);
+}
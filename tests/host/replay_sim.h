@@ -0,0 +1,153 @@
+// replay_sim.h — драйвер replay_sim.yaml
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display_tools/display_tools.h"
+#include "host_framebuffer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace replay_sim {
+
+using esphome::display_tools::DisplayTools;
+using esphome::display_tools::DrawCommandType;
+using esphome::display_tools::DrawObject;
+using host_test::HostFramebuffer;
+
+static const char *const TAG = "replay_sim";
+
+struct Event {
+  uint32_t at_ms;
+  std::function<void(DisplayTools *)> apply;
+};
+
+// Вечір "із продакшну", стиснутий у хвилину: ті самі виклики, що роблять сервісні лямбди
+// add_app / del_app / message / climate у matrix-display.yaml
+static std::vector<Event> evening_script(esphome::display::BaseFont *text_font,
+                                         esphome::display::BaseFont *icon_font) {
+  std::vector<Event> events;
+  events.push_back({0, [](DisplayTools *t) {
+                      t->set_temperature_outside(-3.5f);
+                      t->set_temperature_inside(21.0f);
+                      t->set_weather_icon("mdi:weather-snowy");
+                      t->set_temperature_progress({-5, -4, -4, -3, -3, -2, -2, -1});
+                    }});
+  events.push_back({200, [](DisplayTools *t) { t->addApp("weather", "Сніг, вітер 5 м/с", "00CED1", 2); }});
+  events.push_back({400, [text_font, icon_font](DisplayTools *t) {
+                      auto parts = t->make_colored_words({"Кухня", "21.4°", "mdi:weather-sunny"},
+                                                         {"FFFFFF", "00FF00", "FFA500"}, text_font, icon_font);
+                      t->addApp("kitchen", "-", "FFFFFF", 3, "", "FFFFFF", parts);
+                    }});
+  events.push_back({600, [](DisplayTools *t) {
+                      DrawObject frame;
+                      frame.type = DrawCommandType::RECTANGLE;
+                      frame.x1 = 40, frame.y1 = 38, frame.x2 = 86, frame.y2 = 24;
+                      frame.color = esphome::Color(255, 165, 0);
+                      DrawObject bmp;
+                      bmp.type = DrawCommandType::BITMAP;
+                      bmp.x1 = 2, bmp.y1 = 38, bmp.x2 = 16, bmp.y2 = 16;
+                      bmp.bitmap_data.resize(16 * 16 * 3);
+                      for (size_t i = 0; i < bmp.bitmap_data.size(); i++)
+                        bmp.bitmap_data[i] = static_cast<uint8_t>(i * 13);
+                      t->addApp("energy", "-", "FFFFFF", 2, "", "FFFFFF", {}, {frame, bmp});
+                    }});
+  events.push_back({9000, [](DisplayTools *t) { t->addAlert("Дзвінок у двері", "FF0000", "", "FF0000", "14", 2); }});
+  events.push_back({15000, [](DisplayTools *t) { t->patch_text_part("kitchen", "1", "21.9°"); }});
+  events.push_back({21000, [](DisplayTools *t) { t->addApp("weather", "Сніг, вітер 8 м/с", "00CED1", 2); }});
+  events.push_back({27000, [](DisplayTools *t) {
+                      t->addAlert(
+                          "Увага! Повітряна тривога в Київській області. Прямуйте до найближчого укриття. "
+                          "Відбій тривоги буде оголошено окремо. Слідкуйте за повідомленнями.",
+                          "FFFF00", "", "FF0000", "7", 1);
+                    }});
+  events.push_back({40000, [](DisplayTools *t) { t->delApp("energy"); }});
+  events.push_back({46000, [](DisplayTools *t) {
+                      t->set_temperature_outside(-4.0f);
+                      t->set_weather_icon("mdi:weather-night");
+                    }});
+  events.push_back({52000, [](DisplayTools *t) { t->addApp("energy", "1.2 кВт", "FFA500", 2); }});
+  return events;
+}
+
+static uint32_t percentile(std::vector<uint32_t> values, uint8_t pct) {
+  if (values.empty())
+    return 0;
+  const size_t k = std::min(values.size() - 1, values.size() * pct / 100);
+  std::nth_element(values.begin(), values.begin() + k, values.end());
+  return values[k];
+}
+
+}  // namespace replay_sim
+
+// Симулятор без брокера і заліза: годинник анімацій DisplayTools підміняється часом симуляції,
+// кадри йдуть з кроком frame_ms і детермінованими затримками (імітація зависань WiFi/MQTT).
+// Траса — JSON Lines як у ${name}/debug/frames ({"f","t","crc","us"}), тож дві версії прошивки
+// порівнює tools/mqtt_session.py compare. Повертає false, якщо трасу не вдалося записати
+static bool run_replay_sim(esphome::display_tools::DisplayTools *tools, esphome::display::BaseFont *text_font,
+                           esphome::display::BaseFont *icon_font, const char *trace_path, uint32_t duration_ms,
+                           uint32_t frame_ms) {
+  using namespace replay_sim;
+  HostFramebuffer fb(128, 64);
+  fb.set_update_interval(frame_ms);
+  uint32_t sim_ms = 0;
+  tools->get_animation_clock().set_fixed_step(0);
+  tools->get_animation_clock().set_time_source([&sim_ms]() { return sim_ms; });
+
+  FILE *trace = std::fopen(trace_path, "w");
+  if (trace == nullptr) {
+    ESP_LOGE(TAG, "Cannot open %s", trace_path);
+    return false;
+  }
+
+  const std::vector<Event> events = evening_script(text_font, icon_font);
+  size_t next_event = 0;
+  uint32_t rng = 0x2545F491;
+  std::vector<uint32_t> render_us, interval_ms;
+  uint32_t frames = 0, distinct = 0, last_crc = 0, skipped = 0, window_frames = 0;
+  const auto &clock = tools->get_animation_clock();
+  while (sim_ms <= duration_ms) {
+    while (next_event < events.size() && events[next_event].at_ms <= sim_ms)
+      events[next_event++].apply(tools);
+
+    fb.clear_pixels();
+    const auto t0 = std::chrono::steady_clock::now();
+    tools->render_screen(fb);
+    const auto t1 = std::chrono::steady_clock::now();
+    const uint32_t us = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(t1 - t0).count());
+    const uint32_t crc = fb.crc();
+    std::fprintf(trace, "{\"f\":%u,\"t\":%u,\"crc\":\"%08x\",\"us\":%u}\n", (unsigned) frames, (unsigned) sim_ms,
+                 (unsigned) crc, (unsigned) us);
+    render_us.push_back(us);
+    // DisplayTools скидає статистику годинника кожні ~10 с, забравши пропущені кроки вікна
+    if (clock.interval_count() < window_frames)
+      skipped += tools->get_skipped_steps();
+    window_frames = clock.interval_count();
+    if (frames == 0 || crc != last_crc)
+      distinct++;
+    last_crc = crc;
+    frames++;
+
+    // Кожен ~64-й кадр затримується на 40..167 мс: скрол має наздогнати, а не загальмувати
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    const uint32_t step = (rng & 63) == 0 ? 40 + (rng >> 8) % 128 : frame_ms;
+    interval_ms.push_back(step);
+    sim_ms += step;
+  }
+  const bool ok = std::fclose(trace) == 0;
+  tools->get_animation_clock().set_time_source(nullptr);
+
+  skipped += clock.skipped_steps();
+  ESP_LOGI(TAG, "%u frames (%u distinct) over %u ms -> %s", (unsigned) frames, (unsigned) distinct,
+           (unsigned) duration_ms, trace_path);
+  ESP_LOGI(TAG, "render p50=%u us p99=%u us; frame interval p50=%u ms p99=%u ms, skipped scroll steps=%u",
+           (unsigned) percentile(render_us, 50), (unsigned) percentile(render_us, 99),
+           (unsigned) percentile(interval_ms, 50), (unsigned) percentile(interval_ms, 99), (unsigned) skipped);
+  return ok;
+}
@@ -0,0 +1,224 @@
+// snapshot_roundtrip.h — драйвер snapshot_roundtrip.yaml
+#pragma once
+
+#include "esphome.h"
+#include "esphome/components/display_tools/display_tools.h"
+#include "esphome/components/display_tools/snapshot.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace snapshot_roundtrip {
+
+using esphome::Color;
+using esphome::display_tools::BitmapAnimation;
+using esphome::display_tools::DisplayTools;
+using esphome::display_tools::DrawCommandType;
+using esphome::display_tools::DrawObject;
+
+static const char *const TAG = "snapshot_roundtrip";
+
+static bool check(bool cond, const char *what) {
+  if (!cond)
+    ESP_LOGE(TAG, "FAIL: %s", what);
+  return cond;
+}
+
+static bool same_color(const Color &a, const Color &b) { return a.r == b.r && a.g == b.g && a.b == b.b; }
+
+static std::vector<uint8_t> bitmap_bytes(int w, int h, uint8_t seed) {
+  std::vector<uint8_t> rgb(static_cast<size_t>(w * h * 3));
+  for (size_t i = 0; i < rgb.size(); i++)
+    rgb[i] = static_cast<uint8_t>(seed + i * 7);
+  return rgb;
+}
+
+// Apps з усіма видами вмісту, що пише знімок: частини тексту зі шрифтом і id, фігури,
+// текст, бітмапа даними, та сама бітмапа за хешем і анімація з двома кадрами змін
+static void add_apps(DisplayTools *tools, esphome::display::BaseFont *font) {
+  tools->addApp("plain", "hello", "FF0000", 3, "mdi:weather-sunny", "00FF00");
+
+  std::vector<DisplayTools::ColoredWord> parts{{"Темп.", Color(10, 20, 30), font, "label", -1, 0},
+                                               {"21°", Color(200, 100, 0), font, "value", -1, 0}};
+  tools->addApp("parts", "-", "FFFFFF", 2, "", "FFFFFF", parts);
+
+  std::vector<DrawObject> cmds;
+  DrawObject line;
+  line.type = DrawCommandType::LINE;
+  line.x1 = 1, line.y1 = 2, line.x2 = 30, line.y2 = 5;
+  line.color = Color(1, 2, 3);
+  cmds.push_back(line);
+
+  DrawObject text;
+  text.type = DrawCommandType::TEXT;
+  text.x1 = 4, text.y1 = 6;
+  text.text = "Київ";
+  text.font = font;
+  text.align = esphome::display::TextAlign::TOP_RIGHT;
+  text.id = "city";
+  cmds.push_back(text);
+
+  DrawObject bmp;
+  bmp.type = DrawCommandType::BITMAP;
+  bmp.x1 = 0, bmp.y1 = 0, bmp.x2 = 8, bmp.y2 = 8;
+  bmp.bitmap_data = bitmap_bytes(8, 8, 3);
+  bmp.id = "logo";
+  cmds.push_back(bmp);
+
+  DrawObject anim;
+  anim.type = DrawCommandType::ANIMATION;
+  anim.x1 = 10, anim.y1 = 0, anim.x2 = 4, anim.y2 = 4;
+  anim.bitmap_data = bitmap_bytes(4, 4, 50);
+  anim.animation = std::make_shared<BitmapAnimation>();
+  anim.animation->add_frame(100);
+  anim.animation->add_frame(150);
+  std::vector<uint8_t> rect = bitmap_bytes(2, 2, 90);
+  anim.animation->add_rect(1, 1, 2, 2, rect.data(), rect.size());
+  anim.animation->add_frame(200);
+  rect = bitmap_bytes(1, 4, 120);
+  anim.animation->add_rect(3, 0, 1, 4, rect.data(), rect.size());
+  cmds.push_back(anim);
+  tools->addApp("draw", "-", "FFFFFF", 4, "", "FFFFFF", {}, cmds);
+
+  // Та сама бітмапа лише хешем: після addApp її дані має знайти сховище
+  DrawObject ref;
+  ref.type = DrawCommandType::BITMAP;
+  ref.x1 = 20, ref.y1 = 0, ref.x2 = 8, ref.y2 = 8;
+  std::vector<uint8_t> logo = bitmap_bytes(8, 8, 3);
+  ref.bitmap_hash = esphome::display_tools::snapshot_crc32(logo.data(), logo.size());
+  tools->addApp("by_hash", "-", "FFFFFF", 2, "", "FFFFFF", {}, {ref});
+}
+
+static const DisplayTools::App_Info *find_app(const std::vector<DisplayTools::App_Info> &apps,
+                                              const std::string &name) {
+  for (const auto &app : apps) {
+    if (app.name == name)
+      return &app;
+  }
+  return nullptr;
+}
+
+static bool check_apps(const std::vector<DisplayTools::App_Info> &apps, esphome::display::BaseFont *font) {
+  bool ok = true;
+  const auto *plain = find_app(apps, "plain");
+  ok &= check(plain != nullptr && plain->body == "HELLO" && plain->duration == 3 && plain->icon == "\U000F0599" &&
+                  same_color(plain->color, Color(255, 0, 0)) && same_color(plain->icon_color, Color(0, 255, 0)),
+              "plain app");
+
+  const auto *parts = find_app(apps, "parts");
+  ok &= check(parts != nullptr && parts->text_parts.size() == 2, "parts app");
+  if (parts != nullptr && parts->text_parts.size() == 2) {
+    const auto &v = parts->text_parts[1];
+    ok &= check(v.text == "21°" && v.id == "value" && v.font == font && same_color(v.color, Color(200, 100, 0)),
+                "text part");
+  }
+
+  const auto *draw = find_app(apps, "draw");
+  ok &= check(draw != nullptr && draw->draw_objects.size() == 4, "draw app");
+  if (draw != nullptr && draw->draw_objects.size() == 4) {
+    const auto &line = draw->draw_objects[0];
+    ok &= check(line.type == DrawCommandType::LINE && line.x2 == 30 && line.y2 == 5 &&
+                    same_color(line.color, Color(1, 2, 3)),
+                "line");
+    const auto &text = draw->draw_objects[1];
+    ok &= check(text.text == "Київ" && text.font == font && text.id == "city" &&
+                    text.align == esphome::display::TextAlign::TOP_RIGHT,
+                "text");
+    const auto &bmp = draw->draw_objects[2];
+    std::vector<uint8_t> logo = bitmap_bytes(8, 8, 3);
+    ok &= check(bmp.bitmap_len() == logo.size() && memcmp(bmp.bitmap_ptr(), logo.data(), logo.size()) == 0,
+                "bitmap data");
+    const auto &anim = draw->draw_objects[3];
+    ok &= check(anim.type == DrawCommandType::ANIMATION && anim.animation != nullptr &&
+                    anim.animation->frame_count() == 3 && anim.animation->frame_duration(2) == 200,
+                "animation frames");
+    // Потік змін: кадр 1 = 1 прямокутник 2x2, кадр 2 = 1 прямокутник 1x4
+    ok &= check(anim.animation != nullptr && anim.animation->stream_size() == (1 + 4 + 12) + (1 + 4 + 12),
+                "animation stream");
+  }
+
+  const auto *by_hash = find_app(apps, "by_hash");
+  std::vector<uint8_t> logo = bitmap_bytes(8, 8, 3);
+  ok &= check(by_hash != nullptr && by_hash->draw_objects.size() == 1 &&
+                  by_hash->draw_objects[0].bitmap_len() == logo.size() &&
+                  memcmp(by_hash->draw_objects[0].bitmap_ptr(), logo.data(), logo.size()) == 0,
+              "bitmap by hash");
+  return ok;
+}
+
+static bool roundtrip_store(esphome::display_tools::SnapshotStore &store, const std::vector<uint8_t> &blob,
+                            const char *name) {
+  std::vector<uint8_t> loaded;
+  bool ok = check(store.save(blob.data(), blob.size()), name);
+  ok = ok && check(store.load(loaded), name);
+  return ok && check(loaded == blob, name);
+}
+
+}  // namespace snapshot_roundtrip
+
+// Знімок apps проходить encode → сховище → decode без втрат; пошкоджений знімок відкидається.
+// true — усі перевірки пройшли
+static bool run_snapshot_roundtrip(esphome::display_tools::DisplayTools *tools, esphome::display::BaseFont *font) {
+  using namespace snapshot_roundtrip;
+  add_apps(tools, font);
+
+  const std::vector<uint8_t> blob = tools->encode_apps_snapshot();
+  bool ok = check(blob.size() > 0, "encode");
+
+  esphome::display_tools::FileSnapshotStore file("snapshot_roundtrip.bin");
+  ok &= roundtrip_store(file, blob, "file store");
+
+  std::vector<uint8_t> loaded;
+  std::vector<DisplayTools::App_Info> apps;
+  ok &= check(file.load(loaded) && tools->decode_apps_snapshot(loaded.data(), loaded.size(), apps), "decode");
+  ok &= check_apps(apps, font);
+
+  // Кодування не залежить від того, що бітмапи вже у сховищі
+  ok &= check(tools->encode_apps_snapshot() == blob, "encode is stable");
+
+  std::vector<uint8_t> corrupt = blob;
+  corrupt[corrupt.size() / 2] ^= 0x40;
+  std::vector<DisplayTools::App_Info> rejected;
+  ok &= check(!tools->decode_apps_snapshot(corrupt.data(), corrupt.size(), rejected), "corrupt snapshot rejected");
+
+  // Слоти preferences: повний знімок, той самий ще раз (без запису) і коротший поверх довшого
+  esphome::display_tools::PreferencesSnapshotStore<DISPLAY_TOOLS_SNAPSHOT_SIZE> prefs(
+      esphome::fnv1_hash("snapshot_roundtrip"));
+  ok &= roundtrip_store(prefs, blob, "preferences store");
+  ok &= roundtrip_store(prefs, blob, "preferences store, unchanged");
+  tools->delApp("draw");
+  const std::vector<uint8_t> smaller = tools->encode_apps_snapshot();
+  ok &= check(smaller.size() < blob.size(), "smaller snapshot");
+  ok &= roundtrip_store(prefs, smaller, "preferences store, shrink");
+
+  // Відновлення під меншим бюджетом пам'яті, ніж той, з яким знімок записано, одразу витісняє зайве
+  tools->set_snapshot_store(&file);
+  ok &= check(tools->restore_apps_snapshot(), "restore");
+  const uint32_t full = tools->get_memory_used(), evicted = tools->get_evicted_apps();
+  tools->set_memory_budget(full - 1);
+  ok &= check(tools->restore_apps_snapshot(), "restore over budget");
+  ok &= check(tools->get_evicted_apps() > evicted && tools->get_memory_used() <= full - 1, "budget after restore");
+  tools->set_memory_budget(0);
+  tools->set_snapshot_store(nullptr);
+
+  // Алерти не витісняють apps, а черга понад 8 відкидає найстаріші з тих, що чекають (не той, що на екрані)
+  tools->set_memory_budget(tools->get_memory_used());
+  const uint32_t evicted_before_alerts = tools->get_evicted_apps();
+  for (int i = 0; i < 10; i++)
+    tools->addAlert("alert " + std::to_string(i), "", "", "", "1", 1);
+  DisplayTools::AlertMessage alert;
+  ok &= check(tools->get_evicted_apps() == evicted_before_alerts, "alerts do not evict apps");
+  ok &= check(tools->get_dropped_alerts() == 2 && tools->getCurrentAlert(alert) && alert.text == "ALERT 0",
+              "alert queue cap");
+  tools->removeCurrentAlert();
+  ok &= check(tools->getCurrentAlert(alert) && alert.text == "ALERT 3", "oldest waiting alerts dropped");
+  while (tools->hasAlert())
+    tools->removeCurrentAlert();
+  tools->set_memory_budget(0);
+
+  ESP_LOGI(TAG, "%s: snapshot %u bytes, %u apps", ok ? "PASS" : "FAIL", (unsigned) blob.size(),
+           (unsigned) apps.size());
+  return ok;
+}
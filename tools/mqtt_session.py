@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""Запис і реплей MQTT-сесій matrix-display.
+
+  record  — пише ${name}/service/{add_app,del_app,message,climate} у JSON Lines:
+            {"t": мс від старту, "topic": "add_app", "payload": {...}}
+  replay  — публікує лог з тими самими інтервалами (--speed для прискорення) і
+            збирає трасу кадрів з ${name}/debug/frames (потрібен frame_trace: true)
+  compare — порівнює дві траси: послідовність різних кадрів (CRC) і час рендеру p50/p99
+
+Для детермінованого порівняння запускайте прошивку на хості з replay_frame_step і
+replay_epoch: тоді анімації і годинник на екрані не залежать від реального часу.
+Без брокера трасу того ж формату пише симулятор tests/host/replay_sim.yaml.
+
+Потрібен paho-mqtt (pip install paho-mqtt).
+"""
+
+import argparse
+import json
+import sys
+import time
+
+SERVICES = ("add_app", "del_app", "message", "climate")
+
+
+def connect(args):
+    import paho.mqtt.client as mqtt
+
+    client = mqtt.Client()
+    if args.username:
+        client.username_pw_set(args.username, args.password)
+    client.connect(args.broker, args.port)
+    return client
+
+
+def cmd_record(args):
+    client = connect(args)
+    prefix = f"{args.name}/service/"
+    start = time.monotonic()
+
+    with open(args.log, "w", encoding="utf-8") as out:
+
+        def on_message(_client, _userdata, msg):
+            try:
+                payload = json.loads(msg.payload)
+            except ValueError:
+                return
+            entry = {
+                "t": int((time.monotonic() - start) * 1000),
+                "topic": msg.topic[len(prefix):],
+                "payload": payload,
+            }
+            out.write(json.dumps(entry, ensure_ascii=False) + "\n")
+            out.flush()
+
+        client.on_message = on_message
+        for service in SERVICES:
+            client.subscribe(prefix + service)
+        print(f"recording {prefix}{{{','.join(SERVICES)}}} -> {args.log}, Ctrl+C to stop")
+        try:
+            client.loop_forever()
+        except KeyboardInterrupt:
+            pass
+
+
+def cmd_replay(args):
+    client = connect(args)
+    frames = open(args.frames, "w", encoding="utf-8") if args.frames else None
+
+    def on_message(_client, _userdata, msg):
+        if frames is not None:
+            frames.write(msg.payload.decode("utf-8"))
+            frames.flush()
+
+    client.on_message = on_message
+    client.subscribe(f"{args.name}/debug/frames")
+    client.loop_start()
+
+    with open(args.log, encoding="utf-8") as log:
+        entries = [json.loads(line) for line in log if line.strip()]
+
+    start = time.monotonic()
+    for entry in entries:
+        due = start + entry["t"] / 1000.0 / args.speed
+        delay = due - time.monotonic()
+        if delay > 0:
+            time.sleep(delay)
+        client.publish(f"{args.name}/service/{entry['topic']}", json.dumps(entry["payload"]))
+    print(f"replayed {len(entries)} messages in {time.monotonic() - start:.1f}s")
+
+    # дати прошивці вивантажити останні кадри
+    time.sleep(args.tail)
+    client.loop_stop()
+    if frames is not None:
+        frames.close()
+
+
+def load_trace(path):
+    with open(path, encoding="utf-8") as f:
+        return [json.loads(line) for line in f if line.strip()]
+
+
+def distinct_frames(trace):
+    out = []
+    for entry in trace:
+        if not out or out[-1] != entry["crc"]:
+            out.append(entry["crc"])
+    return out
+
+
+def percentile(values, p):
+    if not values:
+        return 0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def cmd_compare(args):
+    a, b = load_trace(args.a), load_trace(args.b)
+    for label, trace in ((args.a, a), (args.b, b)):
+        us = [e["us"] for e in trace]
+        print(f"{label}: {len(trace)} frames, render p50={percentile(us, 50)}us p99={percentile(us, 99)}us")
+
+    # Кадри порівнюємо як послідовність змін: момент приходу MQTT між прогонами може зсуватися на кадр
+    da, db = distinct_frames(a), distinct_frames(b)
+    for i, (ca, cb) in enumerate(zip(da, db)):
+        if ca != cb:
+            print(f"output differs at distinct frame #{i}: {ca} != {cb}")
+            return 1
+    if len(da) != len(db):
+        print(f"output differs: {len(da)} vs {len(db)} distinct frames")
+        return 1
+    print(f"output identical: {len(da)} distinct frames")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    for command in ("record", "replay"):
+        p = sub.add_parser(command)
+        p.add_argument("--broker", default="localhost")
+        p.add_argument("--port", type=int, default=1883)
+        p.add_argument("--username")
+        p.add_argument("--password")
+        p.add_argument("--name", default="matrix-display", help="значення substitutions.name")
+        p.add_argument("log", help="файл сесії (JSON Lines)")
+        if command == "replay":
+            p.add_argument("--speed", type=float, default=1.0, help="множник швидкості реплею")
+            p.add_argument("--frames", help="куди писати трасу кадрів")
+            p.add_argument("--tail", type=float, default=3.0, help="секунд очікування кадрів після останнього повідомлення")
+
+    p = sub.add_parser("compare")
+    p.add_argument("a")
+    p.add_argument("b")
+
+    args = parser.parse_args()
+    if args.command == "record":
+        cmd_record(args)
+    elif args.command == "replay":
+        cmd_replay(args)
+    else:
+        sys.exit(cmd_compare(args))
+
+
+if __name__ == "__main__":
+    main()